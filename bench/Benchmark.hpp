@@ -0,0 +1,50 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Measure average time of one call of function.
+ * Function is called once before measuring (warm up), result is the best of several rounds,
+ * so a round disturbed by other processes does not skew it.
+ * 
+ * \param iterations Number of calls in one round.
+ * \return Time of one call in microseconds.
+ */
+template <typename Function>
+double measure(Function&& function, int iterations, int rounds = 5)
+{
+    function();
+
+    double best = 0.0;
+    for (int round = 0; round < rounds; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            function();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        double time = elapsed.count() / iterations;
+        best = round == 0 ? time : std::min(best, time);
+    }
+
+    return best;
+}
+
+/**
+ * Address of the last kept value, read by nobody.
+ */
+inline const void* volatile benchmarkSink = nullptr;
+
+/**
+ * Prevent compiler from removing computation of value.
+ * 
+ */
+template <typename T>
+void keep(const T& value)
+{
+    benchmarkSink = &value;
+}
+
+#endif // !BENCHMARK_HPP
@@ -0,0 +1,156 @@
+// Update of entities: one virtual update per entity of the shared entity table (before UpdateSystem)
+// against one UpdateSystem<T> per final type calling T::update without virtual dispatch.
+//
+// Build: g++ -O2 -std=c++17 bench/DispatchBench.cpp -o dispatch_bench
+//        cl /O2 /EHsc /std:c++17 bench\DispatchBench.cpp
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * Entity with state of similar size as the game's entities, its update does nothing.
+ */
+class Entity
+{
+public:
+    virtual ~Entity() {}
+
+    virtual void update(float) {}
+
+    unsigned int type_{ 1 };
+protected:
+    float x_{ 0.f }, y_{ 0.f };
+    float speedX_{ .1f }, speedY_{ .2f };
+    float timer_{ 0.f };
+    int state_{ 0 };
+    char data_[24]{};
+};
+
+class Projectile final : public Entity
+{
+public:
+    void update(float) override
+    {
+        if (y_ < -10.f || y_ > 610.f)
+            state_ = 1;
+    }
+};
+
+class Enemy final : public Entity
+{
+public:
+    void update(float ms) override
+    {
+        timer_ += ms;
+        if (timer_ > 500.f)
+        {
+            timer_ = 0.f;
+            state_ ^= 1;
+        }
+    }
+};
+
+class Ufo final : public Entity
+{
+public:
+    void update(float) override
+    {
+        if (x_ > 800.f)
+        {
+            x_ = -40.f;
+            ++state_;
+        }
+    }
+};
+
+class Player final : public Entity
+{
+public:
+    void update(float) override
+    {
+        speedX_ = (state_ & 1) ? -.3f : ((state_ & 2) ? .3f : 0.f);
+    }
+};
+
+/**
+ * Block does not override update, so it belongs to no system.
+ */
+class Block final : public Entity {};
+
+/**
+ * Entities of one final type updated by qualified call (as UpdateSystem<T>).
+ */
+template <typename T>
+class System
+{
+public:
+    void add(T* entity) { entities_.push_back(entity); }
+
+    void update(float ms)
+    {
+        for (T* entity : entities_)
+            entity->T::update(ms);
+    }
+private:
+    std::vector<T*> entities_;
+};
+
+int main()
+{
+    const float ms = 16.f;
+    for (std::size_t count : { 10000, 100000 })
+    {
+        std::mt19937 random(1);
+        std::vector<std::shared_ptr<Entity>> entities;
+        System<Projectile> projectiles;
+        System<Enemy> enemies;
+        System<Ufo> ufos;
+        System<Player> players;
+
+        // types are mixed evenly
+        auto add = [&entities](auto& system, auto entity)
+        {
+            system.add(entity.get());
+            entities.push_back(std::move(entity));
+        };
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            switch (i % 5)
+            {
+            case 0: add(projectiles, std::make_shared<Projectile>()); break;
+            case 1: add(enemies, std::make_shared<Enemy>()); break;
+            case 2: add(ufos, std::make_shared<Ufo>()); break;
+            case 3: add(players, std::make_shared<Player>()); break;
+            default: entities.push_back(std::make_shared<Block>()); break;
+            }
+        }
+        // order of entity table after spawns and despawns mixes types
+        std::shuffle(entities.begin(), entities.end(), random);
+
+        int iterations = count <= 10000 ? 2000 : 200;
+        double before = measure([&]()
+        {
+            for (auto&& entity : entities)
+            {
+                if (entity->type_ != 8)
+                    entity->update(ms);
+            }
+        }, iterations);
+        double after = measure([&]()
+        {
+            projectiles.update(ms);
+            enemies.update(ms);
+            ufos.update(ms);
+            players.update(ms);
+        }, iterations);
+
+        std::printf("%zu entities: virtual update %.1f us, update systems %.1f us\n", count, before, after);
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Access to sprites of entities: getter returning shared_ptr by value (before Owned<T>)
+// against getter returning raw pointer to the sprite owned by entity.
+//
+// Build: g++ -O2 -std=c++17 bench/OwnershipBench.cpp -o ownership_bench
+//        cl /O2 /EHsc /std:c++17 bench\OwnershipBench.cpp
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct Sprite
+{
+    float x{ 0.f }, y{ 0.f };
+    float width{ 10.f }, height{ 10.f };
+};
+
+/**
+ * Entity sharing its sprite, every access copies the pointer (atomic increment and decrement).
+ */
+class SharedEntity
+{
+public:
+    SharedEntity() : sprite_(std::make_shared<Sprite>()) {}
+    virtual ~SharedEntity() {}
+
+    std::shared_ptr<Sprite> getSprite() const { return sprite_; }
+private:
+    std::shared_ptr<Sprite> sprite_;
+};
+
+/**
+ * Entity owning its sprite, others get a raw pointer.
+ */
+class OwningEntity
+{
+public:
+    OwningEntity() : sprite_(std::make_unique<Sprite>()) {}
+    virtual ~OwningEntity() {}
+
+    Sprite* getSprite() const { return sprite_.get(); }
+private:
+    std::unique_ptr<Sprite> sprite_;
+};
+
+/**
+ * One frame: each entity's sprite is accessed once (e.g. by render or collision).
+ */
+template <typename T>
+float frame(const std::vector<std::unique_ptr<T>>& entities)
+{
+    float sum = 0.f;
+    for (auto&& entity : entities)
+    {
+        auto sprite = entity->getSprite();
+        sum += sprite->x + sprite->width;
+    }
+
+    return sum;
+}
+
+int main()
+{
+    // entities of one level (enemies, bunkers, projectiles, ui)
+    const std::size_t count = 250;
+    const int iterations = 100000;
+
+    std::mt19937 random(1);
+    std::vector<std::unique_ptr<SharedEntity>> shared;
+    std::vector<std::unique_ptr<OwningEntity>> owning;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        shared.push_back(std::make_unique<SharedEntity>());
+        owning.push_back(std::make_unique<OwningEntity>());
+    }
+    std::shuffle(shared.begin(), shared.end(), random);
+    std::shuffle(owning.begin(), owning.end(), random);
+
+    float sum = 0.f;
+    double before = measure([&]() { sum += frame(shared); }, iterations);
+    double after = measure([&]() { sum += frame(owning); }, iterations);
+    keep(sum);
+
+    std::printf("%zu entities: shared_ptr getter %.0f ns, raw pointer getter %.0f ns per frame\n",
+        count, before * 1000.0, after * 1000.0);
+
+    return 0;
+}
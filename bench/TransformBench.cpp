@@ -0,0 +1,178 @@
+// Movement of entities: virtual update of each entity moving its own sprite (before TransformStore)
+// against one integrate over structure of arrays (TransformStore::integrate).
+// Kernel is the same as ::integrate in src/TransformStore.cpp (without previous positions).
+//
+// Build: g++ -O2 -std=c++17 bench/TransformBench.cpp -o transform_bench (add -mavx for AVX)
+//        cl /O2 /EHsc /std:c++17 bench\TransformBench.cpp (add /arch:AVX for AVX)
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRANSFORM_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define TRANSFORM_SSE
+#endif
+
+struct Vector
+{
+    float x, y;
+};
+
+/**
+ * Sprite allocated separately from its entity (as IRenderPtr before TransformStore).
+ */
+class Sprite
+{
+public:
+    virtual ~Sprite() {}
+
+    Vector getPos() const { return pos_; }
+    void setPos(Vector pos) { pos_ = pos; }
+private:
+    Vector pos_{ 0.f, 0.f };
+    Vector size_{ 10.f, 10.f };
+    char texture_[48]{};
+};
+
+/**
+ * Entity which moves its sprite by its speed in virtual update.
+ */
+class MovingEntity
+{
+public:
+    explicit MovingEntity(std::shared_ptr<Sprite> sprite) : sprite_(std::move(sprite)) {}
+    virtual ~MovingEntity() {}
+
+    virtual void update(float ms)
+    {
+        Vector pos = sprite_->getPos();
+        pos.x += speed_.x * ms;
+        pos.y += speed_.y * ms;
+        sprite_->setPos(pos);
+    }
+
+    unsigned int type_{ 1 };
+private:
+    Vector speed_{ .1f, .2f };
+    std::shared_ptr<Sprite> sprite_;
+    char state_[40]{};
+};
+
+/**
+ * Entity whose position is in transform store, its update has nothing to do.
+ */
+class StoredEntity
+{
+public:
+    explicit StoredEntity(std::shared_ptr<Sprite> sprite) : sprite_(std::move(sprite)) {}
+    virtual ~StoredEntity() {}
+
+    virtual void update(float) {}
+
+    unsigned int type_{ 1 };
+private:
+    unsigned int transform_{ 0 };
+    std::shared_ptr<Sprite> sprite_;
+    char state_[40]{};
+};
+
+void integrate(float* x, float* y, const float* speedX, const float* speedY, std::size_t count, float ms)
+{
+    std::size_t i = 0;
+
+#if defined(TRANSFORM_AVX)
+    __m256 time = _mm256_set1_ps(ms);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 moveX = _mm256_mul_ps(_mm256_loadu_ps(speedX + i), time);
+        __m256 moveY = _mm256_mul_ps(_mm256_loadu_ps(speedY + i), time);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), moveX));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), moveY));
+    }
+#elif defined(TRANSFORM_SSE)
+    __m128 time = _mm_set1_ps(ms);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 moveX = _mm_mul_ps(_mm_loadu_ps(speedX + i), time);
+        __m128 moveY = _mm_mul_ps(_mm_loadu_ps(speedY + i), time);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), moveX));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), moveY));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        x[i] += speedX[i] * ms;
+        y[i] += speedY[i] * ms;
+    }
+}
+
+/**
+ * Create entities with separately allocated sprites, other allocations between them and shuffled
+ * order imitate heap of a running game.
+ * 
+ */
+template <typename T>
+std::vector<std::shared_ptr<T>> createEntities(std::size_t count, std::mt19937& random)
+{
+    std::vector<std::shared_ptr<T>> entities;
+    std::vector<std::shared_ptr<void>> gaps;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        entities.push_back(std::make_shared<T>(std::make_shared<Sprite>()));
+        gaps.push_back(std::shared_ptr<void>(std::malloc(random() % 256 + 16), std::free));
+    }
+    std::shuffle(entities.begin(), entities.end(), random);
+
+    return entities;
+}
+
+int main()
+{
+    const float ms = 16.f;
+    for (std::size_t count : { 10000, 100000 })
+    {
+        std::mt19937 random(1);
+        std::vector<std::shared_ptr<MovingEntity>> moving = createEntities<MovingEntity>(count, random);
+        std::vector<std::shared_ptr<StoredEntity>> stored = createEntities<StoredEntity>(count, random);
+        std::vector<float> x(count, 0.f), y(count, 0.f), speedX(count, .1f), speedY(count, .2f);
+
+        int iterations = count <= 10000 ? 2000 : 200;
+        double before = measure([&]()
+        {
+            for (auto&& entity : moving)
+            {
+                if (entity->type_ != 8)
+                    entity->update(ms);
+            }
+        }, iterations);
+        double after = measure([&]()
+        {
+            integrate(x.data(), y.data(), speedX.data(), speedY.data(), count, ms);
+            for (auto&& entity : stored)
+            {
+                if (entity->type_ != 8)
+                    entity->update(ms);
+            }
+        }, iterations);
+        double kernel = measure([&]()
+        {
+            integrate(x.data(), y.data(), speedX.data(), speedY.data(), count, ms);
+        }, iterations);
+        keep(x[0]);
+
+        std::printf("%zu entities: virtual update %.1f us, integrate and update loop %.1f us, integrate %.1f us\n",
+            count, before, after, kernel);
+    }
+
+    return 0;
+}
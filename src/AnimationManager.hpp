@@ -0,0 +1,100 @@
+#ifndef ANIMATION_MANAGER_HPP
+#define ANIMATION_MANAGER_HPP
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "Bitmap.hpp"
+#include "TextureManager.hpp"
+
+/**
+ * Represent a handle of animation clip stored in animation manager.
+ */
+using ClipId = unsigned int;
+
+/**
+ * Represent an animation, which is shared by all sprites that play it.
+ */
+struct AnimationClip
+{
+	/**
+	 * Texture (sprite sheet) which contains frames.
+	 */
+	TextureId texture;
+	/**
+	 * Frames of the animation (rectangles form sprite sheet).
+	 */
+	std::vector<sf::IntRect> frames;
+	/**
+	 * Collision masks of frames scaled to size of sprite on screen (empty if clip has no masks).
+	 */
+	std::vector<Bitmap> masks;
+};
+
+/**
+ * Represent a manager of animation clips.
+ * (Singleton)
+ */
+class AnimationManager
+{
+public:
+	/**
+	 * Get instance of animation manager.
+	 * 
+	 */
+	static AnimationManager& getInstance()
+	{
+		static AnimationManager instance;
+
+		return instance;
+	}
+
+	/**
+	 * Add new animation clip to manager.
+	 * 
+	 * \param texture Texture which contains frames.
+	 * \param frames Frames of the animation.
+	 * \return Handle of the clip.
+	 */
+	ClipId add(TextureId texture, std::vector<sf::IntRect> frames)
+	{
+		clips_.push_back(AnimationClip{ texture, std::move(frames) });
+
+		return (ClipId)clips_.size() - 1;
+	}
+
+	/**
+	 * Build collision masks of all frames of a clip.
+	 * 
+	 * \param id Handle of clip.
+	 * \param size Size of sprites which play the clip.
+	 */
+	void buildMasks(ClipId id, sf::Vector2u size)
+	{
+		AnimationClip& clip = clips_[id];
+		const sf::Image& image = TextureManager::getInstance().getImage(clip.texture);
+
+		clip.masks.clear();
+		for (const sf::IntRect& frame : clip.frames)
+			clip.masks.emplace_back(image, frame, size);
+	}
+
+	/**
+	 * Get animation clip from manager.
+	 * 
+	 * \param id Handle of clip to get.
+	 */
+	const AnimationClip& get(ClipId id) const
+	{
+		return clips_[id];
+	}
+private:
+	AnimationManager() {}
+
+	/**
+	 * Contains all clips, indexed by their handles.
+	 */
+	std::vector<AnimationClip> clips_;
+};
+
+#endif // !ANIMATION_MANAGER_HPP
\ No newline at end of file
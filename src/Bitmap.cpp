@@ -0,0 +1,124 @@
+#include "Bitmap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+Bitmap::Bitmap(unsigned int width, unsigned int height, bool set)
+    : width_(width), height_(height), wordsPerRow_((width + 63) / 64)
+{
+    words_.assign(wordsPerRow_ * height_, 0);
+    if (!set || width_ == 0)
+        return;
+
+    std::uint64_t last = getColumnMask(wordsPerRow_ - 1, 0, width_ - 1);
+    for (unsigned int row = 0; row < height_; ++row)
+    {
+        std::fill_n(words_.begin() + row * wordsPerRow_, wordsPerRow_ - 1, ~std::uint64_t(0));
+        words_[row * wordsPerRow_ + wordsPerRow_ - 1] = last;
+    }
+}
+
+Bitmap::Bitmap(const sf::Image& image, const sf::IntRect& frame, sf::Vector2u size)
+    : Bitmap(size.x, size.y, false)
+{
+    // pixel of mask is set when the frame pixel drawn at its center is visible
+    for (unsigned int y = 0; y < height_; ++y)
+    {
+        unsigned int sourceY = frame.top + (unsigned int)((y + .5f) * frame.height / height_);
+        for (unsigned int x = 0; x < width_; ++x)
+        {
+            unsigned int sourceX = frame.left + (unsigned int)((x + .5f) * frame.width / width_);
+            sf::Color color = image.getPixel(sourceX, sourceY);
+            if (color.a >= 128 && std::max({ color.r, color.g, color.b }) >= 64)
+                set(x, y);
+        }
+    }
+}
+
+bool Bitmap::empty() const
+{
+    return std::all_of(words_.begin(), words_.end(), [](std::uint64_t word) { return word == 0; });
+}
+
+void Bitmap::clearRow(int row, int first, int last)
+{
+    first = std::max(first, 0);
+    last = std::min(last, (int)width_ - 1);
+    if (row < 0 || row >= (int)height_ || first > last)
+        return;
+
+    for (unsigned int word = first / 64; word <= (unsigned int)last / 64; ++word)
+        words_[row * wordsPerRow_ + word] &= ~getColumnMask(word, first, last);
+}
+
+void Bitmap::clear(const sf::IntRect& pixels)
+{
+    for (int row = pixels.top; row < pixels.top + pixels.height; ++row)
+        clearRow(row, pixels.left, pixels.left + pixels.width - 1);
+}
+
+void Bitmap::clearCircle(sf::Vector2f center, float radius)
+{
+    int first = (int)std::floor(center.y - radius);
+    int last = (int)std::ceil(center.y + radius);
+    for (int row = first; row <= last; ++row)
+    {
+        float dy = row + .5f - center.y;
+        if (dy * dy > radius * radius)
+            continue;
+
+        float half = std::sqrt(radius * radius - dy * dy);
+        clearRow(row, (int)std::floor(center.x - half), (int)std::ceil(center.x + half) - 1);
+    }
+}
+
+bool Bitmap::sweep(sf::Vector2f origin, const sf::FloatRect& box, sf::Vector2f move, float& time) const
+{
+    // pixels covered by whole movement of box
+    float areaLeft = std::min(box.left, box.left + move.x) - origin.x;
+    float areaTop = std::min(box.top, box.top + move.y) - origin.y;
+    int left = std::max(0, (int)std::floor(areaLeft));
+    int top = std::max(0, (int)std::floor(areaTop));
+    int right = std::min((int)width_ - 1, (int)std::ceil(areaLeft + box.width + std::abs(move.x)) - 1);
+    int bottom = std::min((int)height_ - 1, (int)std::ceil(areaTop + box.height + std::abs(move.y)) - 1);
+    if (left > right || top > bottom)
+        return false;
+
+    // rows are tested in direction of movement, so the first row with a set pixel is the hit one
+    int step = move.y < 0 ? -1 : 1;
+    int row = move.y < 0 ? bottom : top;
+    int end = (move.y < 0 ? top : bottom) + step;
+    for (; row != end; row += step)
+    {
+        for (unsigned int word = left / 64; word <= (unsigned int)right / 64; ++word)
+        {
+            if ((words_[row * wordsPerRow_ + word] & getColumnMask(word, left, right)) == 0)
+                continue;
+
+            float rowTop = origin.y + row;
+            if (move.y < 0)
+                time = (rowTop + 1 - box.top) / move.y;
+            else if (move.y > 0)
+                time = (rowTop - box.top - box.height) / move.y;
+            else
+                time = 0.f;
+            time = std::min(std::max(time, 0.f), 1.f);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::uint64_t Bitmap::getColumnMask(unsigned int word, int first, int last)
+{
+    int begin = (int)word * 64;
+    int low = std::max(first, begin) - begin;
+    int high = std::min(last, begin + 63) - begin;
+    if (low > high)
+        return 0;
+
+    std::uint64_t upTo = high == 63 ? ~std::uint64_t(0) : (std::uint64_t(1) << (high + 1)) - 1;
+    return upTo & ~((std::uint64_t(1) << low) - 1);
+}
@@ -0,0 +1,101 @@
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Represent a 1-bit image (each pixel is set or not) stored as rows of 64 bit words,
+ * so a range of columns can be tested or cleared one word at a time.
+ * Used for destructible bunkers and for pixel-accurate collision masks of sprites.
+ */
+class Bitmap
+{
+public:
+    Bitmap() {}
+    /**
+     * Create bitmap with all pixels set or all pixels cleared.
+     * 
+     */
+    Bitmap(unsigned int width, unsigned int height, bool set);
+    /**
+     * Create mask of visible (opaque and not black) pixels of a frame, scaled to specific size.
+     * 
+     * \param image Image which contains frame.
+     * \param frame Rectangle of frame in image.
+     * \param size Size of mask (size of frame on screen).
+     */
+    Bitmap(const sf::Image& image, const sf::IntRect& frame, sf::Vector2u size);
+
+    unsigned int getWidth() const { return width_; }
+    unsigned int getHeight() const { return height_; }
+    /**
+     * Determine if pixel is set.
+     * 
+     */
+    bool get(unsigned int x, unsigned int y) const
+    {
+        return (words_[y * wordsPerRow_ + x / 64] & (std::uint64_t(1) << (x % 64))) != 0;
+    }
+    /**
+     * Set pixel.
+     * 
+     */
+    void set(unsigned int x, unsigned int y)
+    {
+        words_[y * wordsPerRow_ + x / 64] |= std::uint64_t(1) << (x % 64);
+    }
+    /**
+     * Determine if no pixel is set.
+     * 
+     */
+    bool empty() const;
+
+    /**
+     * Clear pixels of one row from first to last column (inclusive).
+     * 
+     */
+    void clearRow(int row, int first, int last);
+    /**
+     * Clear pixels inside rectangle.
+     * 
+     */
+    void clear(const sf::IntRect& pixels);
+    /**
+     * Clear pixels inside circle.
+     * 
+     * \param center Center of circle in pixels.
+     * \param radius Radius of circle in pixels.
+     */
+    void clearCircle(sf::Vector2f center, float radius);
+
+    /**
+     * Find time of impact of a moving box with set pixels of bitmap.
+     * Rows are tested in direction of vertical movement, time is computed from the first row
+     * with a set pixel in columns covered by the box.
+     * 
+     * \param origin Position of bitmap's top-left corner (one pixel of bitmap is one unit).
+     * \param box Box at the start of movement.
+     * \param move Movement of the box.
+     * \param time Part of movement (0 to 1) after which box touches set pixel.
+     * \return True if box hits set pixel during movement.
+     */
+    bool sweep(sf::Vector2f origin, const sf::FloatRect& box, sf::Vector2f move, float& time) const;
+private:
+    unsigned int width_{ 0 };
+    unsigned int height_{ 0 };
+    unsigned int wordsPerRow_{ 0 };
+    /**
+     * Pixels, row after row, bits behind the last column are never set.
+     */
+    std::vector<std::uint64_t> words_;
+
+    /**
+     * Get mask of columns from first to last (inclusive) which belong to one word of a row.
+     * 
+     */
+    static std::uint64_t getColumnMask(unsigned int word, int first, int last);
+};
+
+#endif // !BITMAP_HPP
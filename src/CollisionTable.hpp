@@ -0,0 +1,193 @@
+#ifndef COLLISION_TABLE_HPP
+#define COLLISION_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "Entities.hpp"
+
+/**
+ * Represent a response to collision of source entity with one of its targets.
+ * Source (e.g. projectile) is removed by every response except Ignore.
+ */
+enum class Response : unsigned int
+{
+    /**
+     * Collision has no effect.
+     */
+    Ignore,
+    /**
+     * Target is destroyed and its score is added to score bar.
+     */
+    Score,
+    /**
+     * Target is damaged around the impact (e.g. bunker erodes).
+     */
+    Damage,
+    /**
+     * Target loses one life of its life bar (see GameState::applyCommands).
+     */
+    Life,
+};
+
+/**
+ * Response to collision of source of type Source with target of type Target.
+ * Collisions are ignored by default, new pairings are added by specialization.
+ */
+template <EntityType Source, EntityType Target>
+constexpr Response collisionResponse = Response::Ignore;
+
+template <>
+constexpr Response collisionResponse<EntityType::Projectile, EntityType::Enemy> = Response::Score;
+template <>
+constexpr Response collisionResponse<EntityType::Projectile, EntityType::Formation> = Response::Score;
+template <>
+constexpr Response collisionResponse<EntityType::Projectile, EntityType::Structure> = Response::Damage;
+template <>
+constexpr Response collisionResponse<EntityType::Projectile, EntityType::Player> = Response::Life;
+
+/**
+ * Concrete class of all entities of type Type which hides methods used by responses
+ * (Entity if entities of the type use only methods of Entity).
+ */
+template <EntityType Type>
+struct EntityClass { using type = Entity; };
+
+template <>
+struct EntityClass<EntityType::Structure> { using type = Bunker; };
+template <>
+struct EntityClass<EntityType::Formation> { using type = Formation; };
+
+/**
+ * Number of rows and columns of collision table (None and one for each bit of EntityType).
+ */
+constexpr std::size_t collisionTypeCount = 7;
+
+/**
+ * Get row or column of collision table for entity type (entities have at most one type bit).
+ * 
+ */
+constexpr std::size_t getCollisionIndex(EntityType type)
+{
+    unsigned int bits = static_cast<unsigned int>(type);
+    std::size_t index = 0;
+    while (bits != 0 && (bits & (1u << index)) == 0)
+        ++index;
+
+    return bits == 0 ? 0 : index + 1;
+}
+
+/**
+ * Get entity type of row or column of collision table.
+ * 
+ */
+constexpr EntityType getCollisionType(std::size_t index)
+{
+    return index == 0 ? EntityType::None : static_cast<EntityType>(1u << (index - 1));
+}
+
+/**
+ * Find time of impact of a moving box with target of type Type (see Entity::sweep),
+ * method of target's concrete class is called directly.
+ * 
+ */
+template <EntityType Type>
+bool sweepAs(const Entity* target, const Rectf& box, sf::Vector2f move, float& time)
+{
+    using Class = typename EntityClass<Type>::type;
+    return static_cast<const Class*>(target)->Class::sweep(box, move, time);
+}
+
+/**
+ * Apply response to collision of source of type Source with target of type Target.
+ * 
+ * \param impact Rigid body of source in the moment of impact.
+ */
+template <EntityType Source, EntityType Target>
+void respondAs(GameState& state, Entity* source, Entity* target, const Rectf& impact)
+{
+    using Class = typename EntityClass<Target>::type;
+    constexpr Response response = collisionResponse<Source, Target>;
+
+    if constexpr (response == Response::Score)
+    {
+        Entity* destroyed = static_cast<Class*>(target)->getHit(impact);
+        if (destroyed != nullptr)
+        {
+            if (destroyed->getScore() != 0)
+                state.getScoreBar()->addScore(destroyed->getScore());
+            state.removeEntity(destroyed->getId());
+        }
+    }
+    else if constexpr (response == Response::Damage)
+        static_cast<Class*>(target)->damage(impact);
+    else if constexpr (response == Response::Life)
+        state.removeEntity(target->getId());
+
+    state.removeEntity(source->getId());
+}
+
+using CollisionSweep = bool (*)(const Entity* target, const Rectf& box, sf::Vector2f move, float& time);
+using CollisionRespond = void (*)(GameState& state, Entity* source, Entity* target, const Rectf& impact);
+
+/**
+ * Get response function of a pair, ignored pairs have no function (and no code is generated for them).
+ * 
+ */
+template <EntityType Source, EntityType Target>
+constexpr CollisionRespond getCollisionRespond()
+{
+    if constexpr (collisionResponse<Source, Target> == Response::Ignore)
+        return nullptr;
+    else
+        return &respondAs<Source, Target>;
+}
+
+template <std::size_t... Indices>
+constexpr std::array<CollisionSweep, sizeof...(Indices)> makeSweepTable(std::index_sequence<Indices...>)
+{
+    return { &sweepAs<getCollisionType(Indices)>... };
+}
+
+template <std::size_t... Indices>
+constexpr std::array<CollisionRespond, sizeof...(Indices)> makeRespondTable(std::index_sequence<Indices...>)
+{
+    return { getCollisionRespond<getCollisionType(Indices / collisionTypeCount),
+        getCollisionType(Indices % collisionTypeCount)>()... };
+}
+
+/**
+ * Sweep function for each target type.
+ */
+inline constexpr std::array<CollisionSweep, collisionTypeCount> collisionSweeps =
+    makeSweepTable(std::make_index_sequence<collisionTypeCount>());
+/**
+ * Response function for each pair of source and target type (row after row), nullptr for ignored pairs.
+ */
+inline constexpr std::array<CollisionRespond, collisionTypeCount * collisionTypeCount> collisionResponds =
+    makeRespondTable(std::make_index_sequence<collisionTypeCount * collisionTypeCount>());
+
+/**
+ * Find time of impact of a moving box with a target (see Entity::sweep) without virtual dispatch.
+ * 
+ */
+inline bool sweepTarget(const Entity* target, const Rectf& box, sf::Vector2f move, float& time)
+{
+    return collisionSweeps[getCollisionIndex(target->getType())](target, box, move, time);
+}
+
+/**
+ * Apply response to collision of source with its target without virtual dispatch.
+ * 
+ * \param impact Rigid body of source in the moment of impact.
+ */
+inline void respondToCollision(GameState& state, Entity* source, Entity* target, const Rectf& impact)
+{
+    CollisionRespond respond = collisionResponds[getCollisionIndex(source->getType()) * collisionTypeCount +
+        getCollisionIndex(target->getType())];
+    if (respond != nullptr)
+        respond(state, source, target, impact);
+}
+
+#endif // !COLLISION_TABLE_HPP
@@ -0,0 +1,55 @@
+#include "CommandBuffer.hpp"
+#include "Entity.hpp"
+
+#include <algorithm>
+
+void CommandBuffer::Batch::clear()
+{
+    despawns.clear();
+    spawns.clear();
+}
+
+void CommandBuffer::spawn(Spawn spawn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    spawn.sequence = (unsigned int)recorded_.spawns.size();
+    recorded_.spawns.push_back(std::move(spawn));
+}
+
+void CommandBuffer::despawn(std::uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recorded_.despawns.push_back(id);
+}
+
+CommandBuffer::Batch& CommandBuffer::take()
+{
+    // applied batch becomes the recorded one, both keep their capacity
+    applied_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(applied_, recorded_);
+    }
+    Batch& batch = applied_;
+
+    // each entity is despawned only once, archetype is in the high bits of id
+    std::sort(batch.despawns.begin(), batch.despawns.end());
+    batch.despawns.erase(std::unique(batch.despawns.begin(), batch.despawns.end()), batch.despawns.end());
+
+    // spawns of one archetype keep order in which they were recorded (std::sort does not allocate)
+    std::sort(batch.spawns.begin(), batch.spawns.end(), [](const Spawn& left, const Spawn& right)
+    {
+        EntityType leftType = left.entity->getType();
+        EntityType rightType = right.entity->getType();
+        return leftType != rightType ? leftType < rightType : left.sequence < right.sequence;
+    });
+
+    return batch;
+}
+
+void CommandBuffer::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recorded_.clear();
+    applied_.clear();
+}
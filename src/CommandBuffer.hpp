@@ -0,0 +1,91 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Owned.hpp"
+
+class Entity;
+class GameState;
+
+/**
+ * Represent a buffer of structural changes (spawns and despawns of entities) recorded
+ * during update and applied at once on the end of it.
+ * Recording is guarded by a mutex, so commands can be recorded from several threads.
+ * Buffer keeps two batches (recorded and applied) and swaps them, so their memory is reused
+ * and recording in steady state does not allocate.
+ */
+class CommandBuffer
+{
+public:
+    /**
+     * Represent an entity which waits to be added.
+     */
+    struct Spawn
+    {
+        Owned<Entity> entity;
+        /**
+         * Adds entity to update system of its concrete type.
+         */
+        void (*attach)(GameState& state, Entity* entity);
+        /**
+         * Order in which spawn was recorded (assigned by CommandBuffer::spawn).
+         */
+        unsigned int sequence{ 0 };
+    };
+    /**
+     * Represent all commands recorded during one update.
+     */
+    struct Batch
+    {
+        /**
+         * Ids of entities to despawn (or respawn if they still have a life), sorted and unique,
+         * so entities of one archetype table are next to each other.
+         */
+        std::vector<std::uint64_t> despawns;
+        /**
+         * Entities to spawn, grouped by their archetype.
+         */
+        std::vector<Spawn> spawns;
+
+        /**
+         * Remove all commands, memory of the batch is kept.
+         * 
+         */
+        void clear();
+    };
+
+    /**
+     * Record spawn of an entity.
+     * 
+     */
+    void spawn(Spawn spawn);
+    /**
+     * Record despawn of an entity, entity can be despawned several times in one update.
+     * 
+     * \param id Id of entity to despawn.
+     */
+    void despawn(std::uint64_t id);
+    /**
+     * Take all recorded commands, commands recorded while the batch is applied belong to the next one.
+     * 
+     * \return Batch owned by the buffer, valid until the next take.
+     */
+    Batch& take();
+    /**
+     * Drop all recorded commands.
+     * 
+     */
+    void clear();
+private:
+    std::mutex mutex_;
+    Batch recorded_;
+    /**
+     * Batch returned by the last take.
+     */
+    Batch applied_;
+};
+
+#endif // !COMMAND_BUFFER_HPP
@@ -1,146 +1,287 @@
 #include "Entities.hpp"
 #include "Game.hpp"
-#include "GameStates/LevelState.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
-#include <windows.h>
 
-#define WIN32_LEAN_AND_MEAN
+Bunker::Bunker(GameState* state, sf::Vector2f pos, sf::Vector2u size)
+    : Entity{ state, RectSprite(pos, sf::Vector2f((float)size.x, (float)size.y), sf::Color::Green), EntityType::Structure },
+    pixels_(size.x, size.y, true) {}
 
-void Enemy::update(const sf::Time& elapsed)
+void Bunker::capture(RenderSnapshot& snapshot)
 {
-    sf::Vector2f pos = getSprite()->getPos();
+    // pixels are copied only after bunker was damaged, renderer updates its texture then
+    if (dirty_)
+    {
+        published_ = std::make_shared<const Bitmap>(pixels_);
+        dirty_ = false;
+    }
+
+    Rectf bounds = getRigid();
+    snapshot.addBitmap(getId(), sf::Vector2f(bounds.left, bounds.top), published_, sf::Color::Green);
+}
+
+bool Bunker::sweep(const Rectf& box, sf::Vector2f move, float& time) const
+{
+    Rectf bounds = getRigid();
+    return pixels_.sweep(sf::Vector2f(bounds.left, bounds.top), box, move, time);
+}
+
+void Bunker::damage(const Rectf& impact)
+{
+    // erode circle around the impact
+    Rectf bounds = getRigid();
+    sf::Vector2f center(impact.left + impact.width / 2 - bounds.left, impact.top + impact.height / 2 - bounds.top);
+    pixels_.clearCircle(center, std::max(impact.width, impact.height) + 2.f);
+    dirty_ = true;
+
+    // bunker without any pixel is removed
+    if (pixels_.empty())
+        getGameState()->removeEntity(getId());
+}
+
+void Bunker::erase(const sf::IntRect& pixels)
+{
+    pixels_.clear(pixels);
+    dirty_ = true;
+}
 
-    // Determine if enemy should fire a projectile
-    if (((float)rand() / RAND_MAX) <= fireChance_)
+void Formation::update(const sf::Time& elapsed)
+{
+    // shots are scheduled, not rolled for each enemy
+    nextShot_ -= elapsed.asMicroseconds() / 1000.f;
+    if (nextShot_ <= 0.f)
     {
-        // Create a projectile entitiy and fire it.
-        float speed = .6f;
-        IRenderPtr sprite = std::make_shared<RectSprite>(
-            pos, sf::Vector2f(3.f, 5.f), sf::Color::Green
-        );
-        EntityType target = EntityType::Player | EntityType::Structure;
-        getGameState()->addEntity(std::make_shared<Projectile>(
-            getGameState(), sprite, speed, target
-        ));
+        if (!shooters_.empty())
+            fire();
+        nextShot_ += drawShotDelay();
     }
 
-    // movement
-    if (move_)
+    // movement, interval between steps shrinks as enemies die
+    total_ += elapsed.asMicroseconds() / 1000.f;
+    float needed = count_ == 0 ? maxInterval_ : minInterval_ + (maxInterval_ - minInterval_) * live_ / count_;
+    if (live_ > 0 && total_ >= needed)
     {
-        if (down_)
-        {
-            pos.y += abs(distance_);
-            down_ = false;
-        }
-        else
+        total_ -= needed;
+        march();
+    }
+
+    if (dirty_)
+        refresh();
+}
+
+void Formation::march()
+{
+    sf::Vector2f offset(distance_, 0.f);
+    if (++steps_ > maxSteps_)
+    {
+        steps_ = 0;
+        distance_ *= -1;
+        offset = sf::Vector2f(0.f, std::abs(distance_));
+    }
+
+    // all alive enemies are moved by one batch
+    marching_.clear();
+    for (unsigned int row = 0; row < rows_; ++row)
+    {
+        for (unsigned int column = 0; column < columns_; ++column)
         {
-            pos.x += distance_;
-        }
+            if (!alive_.get(column, row))
+                continue;
 
-        move_ = false;
-        needed_ -= timeAcc_;
-        fireChance_ += fireAcc_;
-        sprite_->NextFrame();
+            Enemy* enemy = members_[row * columns_ + column];
+            enemy->nextFrame();
+            marching_.push_back(enemy);
+        }
     }
-    else
+    getGameState()->getTransforms().translate(marching_.data(), marching_.size(), offset);
+
+    fireRate_ += fireAcc_;
+    dirty_ = true;
+}
+
+void Formation::fire()
+{
+    Random& random = getGameState()->getRandom(RandomStream::EnemyFire);
+    unsigned int column = shooters_[random.nextBelow((unsigned int)shooters_.size())];
+    Enemy* shooter = members_[bottom_[column] * columns_ + column];
+
+    // Create a projectile entitiy and fire it.
+    float speed = .6f;
+    EntityType target = EntityType::Player | EntityType::Structure;
+    getGameState()->addEntity(getGameState()->getProjectiles().acquire(
+        getGameState(), shooter->getPos(), speed, target
+    ));
+}
+
+float Formation::drawShotDelay()
+{
+    // uniform number from (0, 1], inverse of exponential distribution
+    float uniform = 1.f - getGameState()->getRandom(RandomStream::EnemyFire).nextFloat();
+    return -std::log(uniform) / fireRate_;
+}
+
+bool Formation::sweep(const Rectf& box, sf::Vector2f move, float& time) const
+{
+    Rectf area(std::min(box.left, box.left + move.x), std::min(box.top, box.top + move.y),
+        box.width + std::abs(move.x), box.height + std::abs(move.y));
+    int left, top, right, bottom;
+    if (!getCells(area, left, top, right, bottom))
+        return false;
+
+    // rows are tested in direction of movement, enemies in the first row with a hit are the closest ones
+    int step = move.y < 0 ? -1 : 1;
+    int row = move.y < 0 ? bottom : top;
+    int end = (move.y < 0 ? top : bottom) + step;
+    for (; row != end; row += step)
     {
-        total_ += elapsed.asMilliseconds();
-        if (total_ >= needed_)
+        bool found = false;
+        for (int column = left; column <= right; ++column)
         {
-            move_ = true;
-            total_ -= needed_;
-            steps_++;
-            if (steps_ > maxSteps_)
+            float enemyTime;
+            if (alive_.get(column, row) && members_[row * columns_ + column]->Entity::sweep(box, move, enemyTime) &&
+                (!found || enemyTime < time))
             {
-                steps_ = 0;
-                distance_ *= -1;
-                down_ = true;
+                found = true;
+                time = enemyTime;
             }
         }
+
+        if (found)
+            return true;
     }
 
-    getSprite()->setPos(pos);
+    return false;
 }
 
-void Enemy::onDead()
+Entity* Formation::getHit(const Rectf& impact)
 {
-    auto levelState = dynamic_cast<LevelState*>(getGameState());
+    // enemy which was hit is in the cell of impact's center
+    int column = (int)std::floor((impact.left + impact.width / 2 - origin_.x) / pitch_.x);
+    int row = (int)std::floor((impact.top + impact.height / 2 - origin_.y) / pitch_.y);
+    if (column < 0 || row < 0 || column >= (int)columns_ || row >= (int)rows_ || !alive_.get(column, row))
+        return nullptr;
 
-    levelState->clusterSize_--;
-    // check for game over
-    if (levelState->clusterSize_ == 0)
+    alive_.clearRow(row, column, column);
+    live_--;
+    dirty_ = true;
+
+    // shooter of the column moves one alive enemy up or column stops shooting
+    if (row == bottom_[column])
     {
-        MessageBoxA(
-            NULL,
-            "Game over!\nYou win.",
-            "GAME OVER",
-            MB_OK
-        );
-        levelState->getGame()->exit();
+        do
+            bottom_[column]--;
+        while (bottom_[column] >= 0 && !alive_.get(column, bottom_[column]));
+
+        if (bottom_[column] < 0)
+        {
+            auto shooter = std::find(shooters_.begin(), shooters_.end(), (unsigned int)column);
+            *shooter = shooters_.back();
+            shooters_.pop_back();
+        }
     }
+
+    return members_[row * columns_ + column];
 }
 
-void Projectile::update(const sf::Time& elapsed)
+void Formation::add(unsigned int column, unsigned int row, Enemy* enemy)
 {
-    Entity::update(elapsed);
+    members_[row * columns_ + column] = enemy;
+    alive_.set(column, row);
+    enemy->setProxy(this);
+    if (bottom_[column] < 0)
+        shooters_.push_back(column);
+    bottom_[column] = std::max(bottom_[column], (int)row);
+    count_++;
+    live_++;
+    dirty_ = true;
+}
 
-    // check for borders
-    sf::Vector2f pos = getSprite()->getPos();
-    if (pos.y <= 0.f || pos.y >= 800.f)
-        getGameState()->removeEntity(getId());
+void Formation::refresh()
+{
+    dirty_ = false;
 
-    // check for collisions
-    std::vector<unsigned int> collided = getGameState()->collision(getId(), target_);
-    if (collided.size() != 0)
+    // bounding box of alive cells
+    int left = (int)columns_, top = (int)rows_, right = -1, bottom = -1;
+    for (int row = 0; row < (int)rows_; ++row)
     {
-        std::vector<unsigned int>::iterator it;
-        if (speed_.y < 0)
-            it = std::max_element(collided.begin(), collided.end());
-        else
-            it = std::min_element(collided.begin(), collided.end());
+        for (int column = 0; column < (int)columns_; ++column)
+        {
+            if (!alive_.get(column, row))
+                continue;
 
-        int score = getGameState()->getEntity(*it)->getScore();
-        if (score != 0)
-            getGameState()->getScoreBar()->addScore(score);
+            // all enemies move together, so any of them determines the origin
+            if (right < 0)
+            {
+                sf::Vector2f pos = members_[row * columns_ + column]->getPos();
+                origin_ = sf::Vector2f(pos.x - (column + .5f) * pitch_.x, pos.y - (row + .5f) * pitch_.y);
+            }
 
-        getGameState()->removeEntity(*it);
-        getGameState()->removeEntity(getId());
+            left = std::min(left, column);
+            top = std::min(top, row);
+            right = std::max(right, column);
+            bottom = std::max(bottom, row);
+        }
     }
+
+    if (right < 0)
+    {
+        setSize(sf::Vector2f(0.f, 0.f));
+        return;
+    }
+
+    sf::Vector2f size((right - left + 1) * pitch_.x, (bottom - top + 1) * pitch_.y);
+    setPos(sf::Vector2f(origin_.x + left * pitch_.x, origin_.y + top * pitch_.y) + size / 2.f);
+    setSize(size);
 }
 
-void Player::update(const sf::Time& elapsed)
+bool Formation::getCells(const Rectf& rect, int& left, int& top, int& right, int& bottom) const
 {
-    Entity::update(elapsed);
+    left = std::max(0, (int)std::floor((rect.left - origin_.x) / pitch_.x));
+    top = std::max(0, (int)std::floor((rect.top - origin_.y) / pitch_.y));
+    right = std::min((int)columns_ - 1, (int)std::floor((rect.left + rect.width - origin_.x) / pitch_.x));
+    bottom = std::min((int)rows_ - 1, (int)std::floor((rect.top + rect.height - origin_.y) / pitch_.y));
+
+    return left <= right && top <= bottom;
+}
 
+void Projectile::update(const sf::Time& elapsed)
+{
+    // check for borders
+    sf::Vector2f pos = getPos();
+    if (pos.y <= 0.f || pos.y >= 800.f)
+        getGameState()->removeEntity(getId());
+}
+
+void Player::update(const sf::Time& elapsed)
+{
     // control handling
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
-        speed_.x = -.4f;
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
-        speed_.x = .4f;
+    const IInput& input = getGameState()->getGame()->getInput();
+    if (input.isPressed(Action::Left))
+        setSpeed(sf::Vector2f(-.4f, 0.f));
+    else if (input.isPressed(Action::Right))
+        setSpeed(sf::Vector2f(.4f, 0.f));
     else
-        speed_.x = 0.f;
+        setSpeed(sf::Vector2f(0.f, 0.f));
 
     // check for borders
-    sf::Vector2f pos = getSprite()->getPos();
+    sf::Vector2f pos = getPos();
     if (pos.x > 800.f)
         pos.x = 800.f;
     else if (pos.x < 0.f)
         pos.x = 0.f;
-    getSprite()->setPos(pos);
+    setPos(pos);
 
     // projectile firing
     if (charge_)
-        total_ += elapsed.asMilliseconds();
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
+        total_ += elapsed.asMicroseconds() / 1000.f;
+    else if (input.isPressed(Action::Fire))
     {
         float speed = -.6f;
-        EntityType target = EntityType::Structure | EntityType::Enemy;
-        IRenderPtr sprite = std::make_shared<RectSprite>(
-            pos, sf::Vector2f(3.f, 5.f), sf::Color::Green
-        );
-        getGameState()->addEntity(std::make_shared<Projectile>(
-            getGameState(), sprite, speed, target
+        EntityType target = EntityType::Structure | EntityType::Enemy | EntityType::Formation;
+        getGameState()->addEntity(getGameState()->getProjectiles().acquire(
+            getGameState(), pos, speed, target
         ));
         charge_ = true;
     }
@@ -151,53 +292,43 @@ void Player::update(const sf::Time& elapsed)
         charge_ = false;
     }
 
-    getSprite()->setPos(pos);
+    setPos(pos);
 }
 
 void Player::respawn()
 {
-    sf::Vector2f pos = getSprite()->getPos();
+    sf::Vector2f pos = getPos();
     pos.x = 400.f;
-    getSprite()->setPos(pos);
+    setPos(pos);
 }
 
 void Player::onDead()
 {
-    MessageBoxA(
-        NULL,
-        "Game over!\nYou lose.",
-        "GAME OVER",
-        MB_OK
-    );
-    getGameState()->getGame()->exit();
+    getGameState()->getGame()->gameOver("Game over!\nYou lose.");
 }
 
-void LifeBar::render(const sf::Time& elapsed, sf::RenderWindow& window)
+void LifeBar::capture(RenderSnapshot& snapshot)
 {
-    IRenderPtr sprite = getSprite();
-    sf::Vector2f pos = sprite->getPos();
+    IRenderable& sprite = getSprite();
+    sf::Vector2f pos = getPos();
 
-    // render each life
+    // capture each life
     for (int i = 0; i < count_; ++i)
     {
         sf::Vector2f newPos = pos;
-        newPos.x = pos.x + sprite->getSize().x * 1.2f * i;
-        sprite->setPos(newPos);
+        newPos.x = pos.x + sprite.getSize().x * 1.2f * i;
+        sprite.setPos(newPos);
 
-        sprite->render(window);
+        captureSprite(snapshot, newPos);
     }
-
-    sprite->setPos(pos);
 }
 
 bool Ufo::spawned = false;
 
 void Ufo::update(const sf::Time& elapsed)
 {
-    Entity::update(elapsed);
-
     // check for border
-    if (getSprite()->getPos().x < 0)
+    if (getPos().x < 0)
     {
         getGameState()->removeEntity(getId());
         spawned = false;
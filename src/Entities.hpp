@@ -1,76 +1,235 @@
 #ifndef ENTITIES_HPP
 #define ENTITIES_HPP
 
+#include "Bitmap.hpp"
 #include "Entity.hpp"
 
+#include <memory>
+#include <vector>
+
 /**
- * Represent a destroyable block entity.
+ * Represent a destructible bunker.
+ * Each pixel of bunker is one bit of a bitmap, shots test and erode whole words
+ * of a row at once and bunker is drawn as one texture updated only after damage
+ * (damaged bunker publishes a new copy of its bitmap to render snapshot).
  */
-class Block final : public Entity
+class Bunker final : public Entity
 {
 public:
-    Block(GameState* state, IRenderPtr sprite)
-        : Entity {state, sprite, EntityType::Structure} {}
+    /**
+     * Create bunker with all pixels intact.
+     * 
+     * \param pos Position of bunker's center.
+     * \param size Size of bunker in pixels.
+     */
+    Bunker(GameState* state, sf::Vector2f pos, sf::Vector2u size);
+
+    void capture(RenderSnapshot& snapshot) override;
+    bool sweep(const Rectf& box, sf::Vector2f move, float& time) const override;
+
+    /**
+     * Erode pixels around an impact, bunker without any pixel is removed.
+     * 
+     * \param impact Rigid body of the other entity in the moment of impact.
+     */
+    void damage(const Rectf& impact);
+    /**
+     * Remove pixels of bunker.
+     * 
+     * \param pixels Rectangle of removed pixels (relative to bunker's top-left corner).
+     */
+    void erase(const sf::IntRect& pixels);
+private:
+    /**
+     * Intact pixels of bunker.
+     */
+    Bitmap pixels_;
+    /**
+     * Copy of pixels shared with render snapshots, it is never changed (damage creates a new copy).
+     */
+    std::shared_ptr<const Bitmap> published_;
+    /**
+     * Determine if pixels were changed since the last capture.
+     */
+    bool dirty_{ true };
 };
 
 /**
  * Represent an enemy entity.
+ * Enemies do not update themselves, they are moved and animated by their formation.
  */
 class Enemy final : public Entity
 {
 public:
+    Enemy(GameState* state, ImageSprite sprite)
+        : Entity {state, std::move(sprite), EntityType::Enemy, 10} {}
+
     /**
-     * \param distance Distance which has to be flyed by the enemy, before enemy should move down.
+     * Show next frame of enemy's animation.
+     * 
      */
-    Enemy(GameState* state, std::shared_ptr<ImageSprite> sprite, float distance)
-        : Entity {state, sprite, EntityType::Enemy}, maxSteps_((int)(distance / distance_)), sprite_(sprite) {}
+    void nextFrame() { getSprite<ImageSprite>().NextFrame(); }
+};
+
+/**
+ * Represent a formation of enemies placed in a regular grid (alien cluster).
+ * Formation is tested for collisions instead of its enemies: after one bounding box test
+ * of whole formation, cells on shot's path are computed from formation's origin and pitch
+ * and only alive enemies in these cells are tested.
+ * Formation also marches its enemies: one timer moves all alive enemies by one step at once
+ * and the interval between steps shrinks with the number of alive enemies.
+ * Only the lowest alive enemy of each column can shoot, time to the next shot is drawn
+ * from an exponential distribution, so firing costs O(1) per update regardless of number of enemies.
+ */
+class Formation final : public Entity
+{
+public:
+    /**
+     * \param columns Number of columns of the grid.
+     * \param rows Number of rows of the grid.
+     * \param pitch Size of one cell of the grid.
+     * \param distance Distance which has to be flyed by the formation, before formation should move down.
+     */
+    Formation(GameState* state, unsigned int columns, unsigned int rows, sf::Vector2f pitch, float distance)
+        : Entity{ state, RectSprite(sf::Vector2f(), sf::Vector2f(), sf::Color::Transparent), EntityType::Formation },
+        columns_(columns), rows_(rows), pitch_(pitch), alive_(columns, rows, false), members_(columns * rows, nullptr),
+        maxSteps_((int)(distance / distance_)), bottom_(columns, -1)
+    {
+        nextShot_ = drawShotDelay();
+    }
 
     void update(const sf::Time& elapsed) override;
-    int getScore() const override { return 10; }
-    void onDead() override;
+    void capture(RenderSnapshot& snapshot) override {}
+    bool sweep(const Rectf& box, sf::Vector2f move, float& time) const override;
+    /**
+     * Get enemy in the cell of impact and mark the cell as dead.
+     * 
+     * \param impact Rigid body of the other entity in the moment of impact.
+     * \return Enemy which was hit or nullptr if the cell is already dead.
+     */
+    Entity* getHit(const Rectf& impact);
+
+    /**
+     * Place enemy to a cell, enemy has to be in the center of the cell.
+     * 
+     */
+    void add(unsigned int column, unsigned int row, Enemy* enemy);
+    /**
+     * Update origin and bounding box of formation from position of its enemies.
+     * Called by update after enemies moved or died, has to be called after all enemies were added.
+     * 
+     */
+    void refresh();
+
+    /**
+     * Get position of top-left corner of the first cell.
+     * 
+     */
+    sf::Vector2f getOrigin() const { return origin_; }
+    /**
+     * Get size of one cell.
+     * 
+     */
+    sf::Vector2f getPitch() const { return pitch_; }
+    /**
+     * Get cells whose enemies are alive.
+     * 
+     */
+    const Bitmap& getAlive() const { return alive_; }
+    /**
+     * Get number of alive enemies.
+     * 
+     */
+    unsigned int getLive() const { return live_; }
 private:
+    unsigned int columns_;
+    unsigned int rows_;
+    sf::Vector2f pitch_;
+    sf::Vector2f origin_;
+    Bitmap alive_;
     /**
-     * Determine if entity should move this tick.
+     * Enemy in each cell (row after row), enemies are owned by game state.
      */
-    bool move_ { false };
+    std::vector<Enemy*> members_;
     /**
-     * Total ellapsed time from last move in ms.
+     * Alive enemies moved by the last step (reused between steps).
      */
-    float total_ { 0.f };
+    std::vector<Entity*> marching_;
+    /**
+     * Number of added and alive enemies.
+     */
+    unsigned int count_{ 0 };
+    unsigned int live_{ 0 };
+    /**
+     * Determine if origin and bounding box have to be refreshed.
+     */
+    bool dirty_{ true };
+
     /**
-     * Minimal amount of time delay before entity next move in ms.
+     * Total ellapsed time from last step in ms.
      */
-    float needed_ { 700.f };
+    float total_{ 0.f };
     /**
-     * How many pixels enemy move.
+     * Delay between steps in ms when all enemies are alive and when only one is alive.
      */
-    float distance_ { 15.f };
+    float maxInterval_{ 700.f };
+    float minInterval_{ 20.f };
+    /**
+     * How many pixels enemies move (sign is direction of movement).
+     */
+    float distance_{ 15.f };
     /**
      * Maximum number of steps in row.
-     * After this number is exceeded, enemy will move to the next row.
+     * After this number is exceeded, formation will move to the next row.
      */
     int maxSteps_;
     /**
      * Current number of steps, counted from last horizontal move.
      */
-    int steps_ { 0 };
+    int steps_{ 0 };
+    /**
+     * Lowest alive row of each column or -1 if column has no alive enemy.
+     */
+    std::vector<int> bottom_;
+    /**
+     * Columns which have at least one alive enemy.
+     */
+    std::vector<unsigned int> shooters_;
+    /**
+     * Time in ms to the next shot.
+     */
+    float nextShot_;
+    /**
+     * Mean number of shots of whole formation per ms.
+     */
+    float fireRate_{ .0003f };
     /**
-     * Determine if enemy should move down this tick.
+     * Acceleration of fire rate (added after each step).
      */
-    bool down_{ false };
+    float fireAcc_{ .00003f };
+
     /**
-     * Probability that enemyt will fire a projectile during this tick.
+     * Move all alive enemies by one step and show their next animation frame.
+     * 
+     */
+    void march();
+    /**
+     * Fire a projectile from the lowest alive enemy of a random column.
+     * 
      */
-    float fireChance_ { .0001f};
+    void fire();
     /**
-     * Acceleration of enemy movement.
+     * Draw time in ms to the next shot from exponential distribution with mean 1 / fireRate_.
+     * 
      */
-    float timeAcc_ { 1.5f };
+    float drawShotDelay();
+
     /**
-     * Acceleration of fire chance.
+     * Get range of cells covered by rectangle (clamped to the grid).
+     * 
+     * \return False if rectangle does not cover any cell.
      */
-    float fireAcc_ { .00001f };
-    std::shared_ptr<ImageSprite> sprite_;
+    bool getCells(const Rectf& rect, int& left, int& top, int& right, int& bottom) const;
 };
 
 /**
@@ -83,15 +242,14 @@ public:
      * \param speed Speed of the projectile.
      * \param target Types of entites who are target of projectile.
      */
-    Projectile(GameState* state, IRenderPtr sprite, float speed, EntityType target)
-        : Entity {state, sprite, EntityType::None}, target_(target)
+    Projectile(GameState* state, Sprite sprite, float speed, EntityType target)
+        : Entity {state, std::move(sprite), EntityType::Projectile}
     {
-        speed_ = sf::Vector2f(0.f, speed);
+        setSpeed(sf::Vector2f(0.f, speed));
+        setTargets(target);
     }
 
     void update(const sf::Time& elapsed) override;
-private:
-    EntityType target_;
 };
 
 /**
@@ -103,10 +261,10 @@ public:
     /**
      * \param count Number of lives.
      */
-    LifeBar(GameState* state, IRenderPtr sprite, int count)
-        : Entity{state, sprite, EntityType::UI}, count_(count) {}
+    LifeBar(GameState* state, Sprite sprite, int count)
+        : Entity{state, std::move(sprite), EntityType::UI}, count_(count) {}
 
-    void render(const sf::Time& elapsed, sf::RenderWindow& window) override;
+    void capture(RenderSnapshot& snapshot) override;
 
     /**
      * Decrease number of lives by one.
@@ -126,16 +284,14 @@ private:
     int count_;
 };
 
-using LBarPtr = std::shared_ptr<LifeBar>;
-
 /**
  * Represent an entity controlled by a player..
  */
-class Player final : public Entity, std::enable_shared_from_this<Player>
+class Player final : public Entity
 {
 public:
-    Player(GameState* state, IRenderPtr sprite)
-        : Entity{state, sprite, EntityType::Player} {}
+    Player(GameState* state, Sprite sprite)
+        : Entity{state, std::move(sprite), EntityType::Player} {}
 
     void update(const sf::Time& elapsed) override;
     void respawn() override;
@@ -164,15 +320,14 @@ public:
     /**
      * \param speed Movement speed of ufo.
      */
-    Ufo(GameState* state, IRenderPtr sprite, float speed)
-        : Entity{state, sprite, EntityType::Enemy}
+    Ufo(GameState* state, Sprite sprite, float speed)
+        : Entity{state, std::move(sprite), EntityType::Enemy, 50}
     {
          spawned = true;
-        speed_ = sf::Vector2f(speed, 0.f);
+        setSpeed(sf::Vector2f(speed, 0.f));
     }
 
     void update(const sf::Time& elapsed) override;  
-    int getScore() const override { return 50; }
 
     /**
      * Determine if ufo is currently spawned.
@@ -186,8 +341,8 @@ public:
 class ScoreBar final : public Entity
 {
 public:
-    ScoreBar(GameState* state, TextPtr text)
-        : Entity{ state, text, EntityType::UI }, text_(text)
+    ScoreBar(GameState* state, TextSprite text)
+        : Entity{ state, std::move(text), EntityType::UI }
     {
         setScore(0);
     }
@@ -207,7 +362,7 @@ public:
         std::string string = std::to_string(score_);
         while (string.length() < 4)
             string = '0' + string;
-        text_->setString(string);
+        getSprite<TextSprite>().setString(string);
     }
     /**
      * Add score to a current score.
@@ -216,7 +371,6 @@ public:
     void addScore(int score) { setScore(score_ + score); }
 
 private:
-    TextPtr text_;
     /**
      * Current score.
      */
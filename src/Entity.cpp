@@ -1,32 +1,45 @@
 #include "Entity.hpp"
+#include "Overlap.hpp"
 
 #include <stdlib.h>
 
-unsigned int Entity::lastId_ = 0;
-
-#include <iostream>
+Entity::Entity(GameState* state, Sprite sprite, const EntityType type, int score)
+    : type_(type), score_(score), state_(state), sprite_(std::move(sprite))
+{
+    transform_ = state_->getTransforms().add(this, getSprite().getPos(), sf::Vector2f(0.f, 0.f),
+        getSprite().getSize());
+}
 
-void Entity::update(const sf::Time& elapsed)
+Entity::~Entity()
 {
-    // update positon
-    sf::Vector2f pos = sprite_->getPos();
-    pos.x += speed_.x * elapsed.asMilliseconds();
-    pos.y += speed_.y * elapsed.asMilliseconds();
-    sprite_->setPos(pos);
+    state_->getTransforms().remove(transform_);
 }
 
-void Entity::render(const sf::Time& elapsed, sf::RenderWindow& window)
+void Entity::capture(RenderSnapshot& snapshot)
 {
-    sprite_->render(window);
+    const TransformStore& transforms = state_->getTransforms();
+    getSprite().setPos(transforms.getPos(transform_));
+    captureSprite(snapshot, transforms.getPrevPos(transform_));
 }
 
 Rectf Entity::getRigid() const
 {
-    Rectf rect;
-    rect.left = sprite_->getPos().x - sprite_->getSize().x / 2 - speed_.x;
-    rect.top = sprite_->getPos().y - sprite_->getSize().y / 2 - speed_.y;
-    rect.width = sprite_->getSize().x + abs(speed_.x);
-    rect.height = sprite_->getSize().y + abs(speed_.y);
+    sf::Vector2f pos = getPos();
+    sf::Vector2f size = getSize();
 
-    return rect;
+    return Rectf(pos - size / 2.f, size);
 }
+
+bool Entity::sweep(const Rectf& box, sf::Vector2f move, float& time) const
+{
+    // image sprites with collision masks are hit only by their visible pixels
+    const ImageSprite* image = std::get_if<ImageSprite>(&sprite_);
+    const Bitmap* mask = image != nullptr ? image->getMask() : nullptr;
+    if (mask != nullptr)
+    {
+        Rectf rigid = getRigid();
+        return mask->sweep(sf::Vector2f(rigid.left, rigid.top), box, move, time);
+    }
+
+    return sweepBox(box, move, getRigid(), time);
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "GameState.hpp"
 #include "IRenderable.hpp"
+#include "SlotMap.hpp"
 
 using Rectf = sf::Rect<float>;
 class LifeBar;
@@ -21,70 +22,139 @@ public:
      * Create new entitiy.
      * 
      * \param state Entity's owner.
-     * \param sprite Entity's sprite.
+     * \param sprite Entity's sprite, stored inside the entity.
      * \param type Entitiy's type.
+     * \param score Score which will be obtained by player when entity is destroyed.
      */
-    Entity(GameState* state, IRenderPtr sprite, const EntityType type)
-        : state_(state), sprite_(sprite), type_(type) {}
-    virtual ~Entity() {}
+    Entity(GameState* state, Sprite sprite, const EntityType type, int score = 0);
+    virtual ~Entity();
 
     /**
      * Update entity's state.
+     * Entity's position is already moved by its speed (see TransformStore::integrate).
      * 
      * \param elapsed Ellapsed time from last update.
      */
-    virtual void update(const sf::Time& elapsed);
+    virtual void update(const sf::Time& elapsed) {}
     /**
-     * Render entity's sprite.
+     * Capture entity's sprite with its positions before and after the last update to render snapshot
+     * (renderer interpolates between them).
      * 
-     * \param elapsed Ellapsed time from last render.
-     * \param window RenderWindow used for rendering.
+     * \param snapshot Snapshot to which will be entity added.
      */
-    virtual void render(const sf::Time& elapsed, sf::RenderWindow& window);
+    virtual void capture(RenderSnapshot& snapshot);
     /**
      * Respawn an entitiy.
      */
     virtual void respawn() {};
     /**
-     * Get rigid body of an entity.
+     * Get rigid body of an entity at its current position.
      * 
      */
-    virtual Rectf getRigid() const;
+    Rectf getRigid() const;
     /**
      * Get score which will be obtained by player when entitiy is destroyed.
      * 
      */
-    virtual int getScore() const { return 0; }
+    int getScore() const { return score_; }
     /**
      * Happens when entitiy die.
      */
     virtual void onDead() {};
+    /**
+     * Find time of impact of a moving box with an entity (entity is at its current position).
+     * Entities with image sprite whose clip has collision masks are tested by the mask
+     * of current frame, other entities by their rigid body.
+     * Collision table calls this method of entity's concrete class without virtual dispatch.
+     * 
+     * \param box Box at the start of movement.
+     * \param move Movement of the box.
+     * \param time Part of movement (0 to 1) after which box touches entity.
+     * \return True if box hits entity during movement.
+     */
+    virtual bool sweep(const Rectf& box, sf::Vector2f move, float& time) const;
+    /**
+     * Get entity which is destroyed by a hit, by default the entity itself.
+     * Not virtual, entities which are hit instead of other entities (e.g. formation of enemies)
+     * hide this method and collision table calls it on entity's concrete class.
+     * 
+     * \param impact Rigid body of the other entity in the moment of impact.
+     * \return Destroyed entity or nullptr if nothing was destroyed.
+     */
+    Entity* getHit(const Rectf& impact) { return this; }
 
     /**
-     * Get id of entitiy.
+     * Get id of entitiy (invalid until entity is added to its game state).
      * 
      */
-    int getId() const { return id_; }
+    std::uint64_t getId() const { return id_; }
     /**
      * Get type of entitiy.
      * 
      */
     EntityType getType() const { return type_; }
     /**
-     * Set life bar wich will be associated with entitiy.
+     * Get types of entities which entity collides with.
+     * 
+     */
+    EntityType getTargets() const { return targets_; }
+    /**
+     * Set life bar wich will be associated with entitiy (life bar is owned by game state).
+     * 
+     */
+    void setLifeBar(LifeBar* lifeBar) { lifeBar_ = lifeBar; }
+    /**
+     * Set entity which is tested for collisions instead of this entity (e.g. formation of enemies).
+     * 
+     * \param proxy Proxy entity or nullptr if entity is tested itself.
+     */
+    void setProxy(Entity* proxy) { proxy_ = proxy; }
+    /**
+     * Get entity which is tested for collisions instead of this entity or nullptr.
      * 
      */
-    void setLifeBar(std::shared_ptr<LifeBar> lifeBar) { lifeBar_ = lifeBar; }
+    Entity* getProxy() const { return proxy_; }
     /**
      * Get life bar which is associated with entitiy of nullptr.
      * 
      */
-    std::shared_ptr<LifeBar> getLifeBar() const { return lifeBar_; }
+    LifeBar* getLifeBar() const { return lifeBar_; }
+    /**
+     * Get position of entity.
+     * 
+     */
+    sf::Vector2f getPos() const { return state_->getTransforms().getPos(transform_); }
+    /**
+     * Get size of entity.
+     * 
+     */
+    sf::Vector2f getSize() const { return state_->getTransforms().getSize(transform_); }
 protected:
     /**
-     * Vector which represent a movement of entitiy.
+     * Set position of entity.
+     * 
      */
-    sf::Vector2f speed_{ 0, 0 };
+    void setPos(sf::Vector2f pos) { state_->getTransforms().setPos(transform_, pos); }
+    /**
+     * Get vector which represent a movement of entitiy (in pixels per ms).
+     * 
+     */
+    sf::Vector2f getSpeed() const { return state_->getTransforms().getSpeed(transform_); }
+    /**
+     * Set vector which represent a movement of entitiy (in pixels per ms).
+     * 
+     */
+    void setSpeed(sf::Vector2f speed) { state_->getTransforms().setSpeed(transform_, speed); }
+    /**
+     * Set size of entity.
+     * 
+     */
+    void setSize(sf::Vector2f size) { state_->getTransforms().setSize(transform_, size); }
+    /**
+     * Set types of entities which entity collides with (EntityType::None by default).
+     * 
+     */
+    void setTargets(EntityType targets) { targets_ = targets; }
 
     /**
      * Get owner of entity.
@@ -95,36 +165,72 @@ protected:
      * Get sprite of entity.
      * 
      */
-    const IRenderPtr getSprite() const { return sprite_; }
-private:
+    IRenderable& getSprite() { return std::visit([](auto& sprite) -> IRenderable& { return sprite; }, sprite_); }
     /**
-     * Id of entity.
+     * Get sprite of entity as its concrete type.
+     * 
      */
-    const unsigned int id_ { lastId_++ };
+    template <typename T>
+    T& getSprite() { return std::get<T>(sprite_); }
+    /**
+     * Capture entity's sprite at its current position.
+     * 
+     * \param prev Position of sprite before the last update.
+     */
+    void captureSprite(RenderSnapshot& snapshot, sf::Vector2f prev) const
+    {
+        std::visit([&snapshot, prev](const auto& sprite) { sprite.capture(snapshot, prev); }, sprite_);
+    }
+private:
+    friend class GameState;
+    friend class TransformStore;
+    template <typename T> friend class UpdateSystem;
 
     /**
-     * Owner of entitiy.
+     * Id of entity, assigned by game state when entity is added.
      */
-    GameState* state_;
+    std::uint64_t id_ { EntityTable::invalid };
+    /**
+     * Index of entity's position, speed and size in owner's transform store.
+     */
+    unsigned int transform_;
     /**
      * Type of entity.
      */
     EntityType type_;
+    /**
+     * Types of entities which entity collides with.
+     */
+    EntityType targets_{ EntityType::None };
+    /**
+     * Score obtained by player when entity is destroyed.
+     */
+    int score_;
+    /**
+     * Owner of entitiy.
+     */
+    GameState* state_;
+
+    /**
+     * Update system which updates this entity or nullptr.
+     */
+    IUpdateSystem* system_{ nullptr };
+    /**
+     * Index of entity in its update system.
+     */
+    unsigned int systemSlot_{ 0 };
     /**
      * Sprite of entity.
      */
-    IRenderPtr sprite_;
+    Sprite sprite_;
     /**
      * Life bar associated with entitiy.
      */
-    std::shared_ptr<LifeBar> lifeBar_{ nullptr };
-
+    LifeBar* lifeBar_{ nullptr };
     /**
-     * Used for generating entitiy ID.
+     * Entity tested for collisions instead of this entity.
      */
-    static unsigned int lastId_;
+    Entity* proxy_{ nullptr };
 };
 
-using EntityPtr = std::shared_ptr<Entity>;
-
 #endif // !ENTITY_HPP
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef FONT_MANAGER_HPP
+#define FONT_MANAGER_HPP
+
+#include <map>
+#include <string>
+#include <SFML/Graphics.hpp>
+
+/**
+ * Represent a manager of fonts.
+ * (Singleton)
+ */
+class FontManager
+{
+public:
+	/**
+	 * Get instance of font manager.
+	 * 
+	 */
+	static FontManager& getInstance()
+	{
+		static FontManager instance;
+
+		return instance;
+	}
+
+	/**
+	 * Load new font to manager.
+	 * 
+	 * \param path Path to a font.
+	 * \param name Name of a font.
+	 * \return True if font was loaded.
+	 */
+	bool load(const std::string& path, const std::string& name)
+	{
+		auto it = fonts_.insert({ name, sf::Font() }).first;
+		return (*it).second.loadFromFile(path);
+	}
+
+	/**
+	 * Get loaded font from manager.
+	 * 
+	 * \param name Name of font to get.
+	 * \return Font with specific name.
+	 */
+	sf::Font& get(const std::string& name)
+	{
+		return fonts_[name];
+	}
+private:
+	FontManager() {}
+
+	/**
+	 * Contains all loaded fonts.
+	 */
+	std::map<std::string, sf::Font> fonts_;
+};
+
+#endif // !FONT_MANAGER_HPP
\ No newline at end of file
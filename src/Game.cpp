@@ -1,28 +1,123 @@
 #include "Game.hpp"
+#include "TextureManager.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+Game::Game(sf::Vector2u windowSize, const std::string title, std::uint64_t seed, bool headless)
+    : winSize_(windowSize), seed_(seed)
+{
+    if (headless)
+    {
+        // textures are kept only as images, so no graphics context is created
+        TextureManager::getInstance().setHeadless(true);
+        input_ = std::make_unique<NullInput>();
+    }
+    else
+    {
+        window_ = std::make_unique<sf::RenderWindow>(sf::VideoMode(windowSize.x, windowSize.y), title);
+        input_ = std::make_unique<KeyboardInput>();
+    }
+}
 
 void Game::run()
 {
     init();
+    if (window_ == nullptr)
+    {
+        runHeadless();
+        return;
+    }
 
-    sf::Clock clock;
-    while (window_.isOpen() && !exit_)
+    // game state is updated on its own thread, this thread only handles events and draws
+    std::thread simulation(&Game::simulate, this);
+    while (window_->isOpen() && !exit_)
     {
         // handle window's events
         sf::Event event;
-        while (window_.pollEvent(event))
+        while (window_->pollEvent(event))
         {
             switch (event.type)
             {
                 case sf::Event::Closed:
-                    window_.close();
+                    window_->close();
                     break;
             }
         }
 
-        sf::Time elapsed = clock.restart();
-        update(elapsed);
-        render(elapsed);
-    }   
+        render();
+    }
+
+    exit();
+    simulation.join();
+}
+
+void Game::simulate()
+{
+    sf::Time last = clock_.getElapsedTime();
+    sf::Time accumulator;
+    while (!exit_)
+    {
+        // game state is updated by fixed ticks, rendering does not depend on them
+        sf::Time now = clock_.getElapsedTime();
+        accumulator += now - last;
+        last = now;
+        unsigned int ticks = 0;
+        while (accumulator >= tick_ && !exit_)
+        {
+            // drop time which cannot be caught up
+            if (maxTicks_ != 0 && ticks == maxTicks_)
+            {
+                accumulator = sf::microseconds(accumulator.asMicroseconds() % tick_.asMicroseconds());
+                break;
+            }
+
+            update(tick_);
+            accumulator -= tick_;
+            ticks++;
+        }
+
+        if (ticks == 0)
+        {
+            sf::sleep(tick_ - accumulator);
+            continue;
+        }
+
+        // snapshot is stamped by time of the last update, renderer interpolates from it
+        RenderSnapshot& snapshot = snapshots_.getBack();
+        state_->capture(snapshot);
+        snapshot.setTime(now - accumulator);
+        snapshots_.publish();
+    }
+}
+
+void Game::runHeadless()
+{
+    sf::Clock clock;
+    sf::Clock report;
+    std::uint64_t reported = 0;
+    while (!exit_)
+    {
+        update(tick_);
+
+        // report speed once per second
+        if (report.getElapsedTime() >= sf::seconds(1.f))
+        {
+            std::cout << "Ticks per second: " << (ticks_ - reported) / report.restart().asSeconds() << std::endl;
+            reported = ticks_;
+        }
+    }
+
+    float seconds = clock.getElapsedTime().asSeconds();
+    std::cout << "Ticks: " << ticks_ << ", seconds: " << seconds << ", ticks per second: "
+        << (seconds > 0.f ? ticks_ / seconds : 0.f) << std::endl;
 }
 
 void Game::setState(GameStatePtr state)
@@ -33,22 +128,50 @@ void Game::setState(GameStatePtr state)
 
 void Game::init()
 {
-    window_.setFramerateLimit(60);
+    if (window_ != nullptr)
+        window_->setFramerateLimit(60);
 }
 
 void Game::update(const sf::Time& elapsed)
 {
+    input_->update();
     state_->update(elapsed);
+
+    ticks_++;
+    if (tickLimit_ != 0 && ticks_ >= tickLimit_)
+        exit();
 }
 
-void Game::render(const sf::Time& elapsed)
+void Game::render()
 {
-    window_.clear(sf::Color::Black);
-    state_->render(elapsed, window_);
-    window_.display();
+    const RenderSnapshot& snapshot = snapshots_.take();
+    float alpha = (clock_.getElapsedTime() - snapshot.getTime()) / tick_;
+
+    window_->clear(sf::Color::Black);
+    renderer_.draw(snapshot, std::min(std::max(alpha, 0.f), 1.f), *window_);
+    window_->display();
 }
 
 void Game::exit()
 {
     exit_ = true;
-}
\ No newline at end of file
+}
+
+void Game::gameOver(const std::string& message)
+{
+#ifdef _WIN32
+    if (window_ != nullptr)
+    {
+        MessageBoxA(
+            NULL,
+            message.c_str(),
+            "GAME OVER",
+            MB_OK
+        );
+    }
+    else
+#endif
+        std::cout << "GAME OVER: " << message << std::endl;
+
+    exit();
+}
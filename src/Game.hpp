@@ -2,13 +2,26 @@
 #define GAME_HPP
 
 #include "GameState.hpp"
+#include "Input.hpp"
+#include "Renderer.hpp"
+#include "RenderSnapshot.hpp"
+#include "TripleBuffer.hpp"
 
 #include <SFML/Window.hpp>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 /**
  * Represents a game.
+ * Game state is updated on simulation thread, which captures a render snapshot after its updates
+ * and publishes it through a triple buffer. Main thread handles window's events and draws the latest
+ * snapshot, so neither thread waits for the other.
+ * Headless game has no window and needs no graphics context: it does not render,
+ * it updates game state as fast as possible and reports number of updates per second.
  */
 class Game
 {
@@ -18,9 +31,10 @@ public:
      * 
      * \param windowSize Size of window.
      * \param title Window's title.
+     * \param seed Seed of random streams of all game states (same seed gives the same game).
+     * \param headless Determine if game runs without window (input is NullInput until setInput).
      */
-    Game(sf::Vector2u windowSize, const std::string title) 
-        : window_(sf::VideoMode(windowSize.x, windowSize.y), title) {}
+    Game(sf::Vector2u windowSize, const std::string title, std::uint64_t seed, bool headless = false);
 
     /**
      * Launch the game loop.
@@ -38,28 +52,107 @@ public:
      * Get window's size.
      * 
      */
-    sf::Vector2u getWinSize() const { return window_.getSize(); }
+    sf::Vector2u getWinSize() const { return window_ != nullptr ? window_->getSize() : winSize_; }
+    /**
+     * Determine if game runs without window.
+     * 
+     */
+    bool isHeadless() const { return window_ == nullptr; }
+    /**
+     * Get source of player's actions.
+     * 
+     */
+    const IInput& getInput() const { return *input_; }
+    /**
+     * Set source of player's actions (e.g. ScriptedInput).
+     * 
+     */
+    void setInput(std::unique_ptr<IInput> input) { input_ = std::move(input); }
+    /**
+     * Get seed of random streams.
+     * 
+     */
+    std::uint64_t getSeed() const { return seed_; }
+    /**
+     * Set maximal number of updates run in one iteration of game loop to catch up after a slow frame,
+     * time which exceeds them is dropped (game slows down instead of freezing).
+     * 
+     * \param ticks Maximal number of updates or 0 for no limit.
+     */
+    void setMaxTicks(unsigned int ticks) { maxTicks_ = ticks; }
+    /**
+     * Set number of updates after which game exits.
+     * 
+     * \param ticks Number of updates or 0 for no limit.
+     */
+    void setTickLimit(std::uint64_t ticks) { tickLimit_ = ticks; }
     /**
      * Exit the game.
      * 
      */
     void exit();
+    /**
+     * Show end of game message and exit the game (headless game and builds without Win32 print the message).
+     * 
+     */
+    void gameOver(const std::string& message);
 private:
-    sf::RenderWindow window_;
+    /**
+     * Window of the game or nullptr if game is headless.
+     */
+    std::unique_ptr<sf::RenderWindow> window_;
+    sf::Vector2u winSize_;
+    std::uint64_t seed_;
+    std::unique_ptr<IInput> input_;
+    /**
+     * Fixed time of one update, game state is always updated by this time.
+     */
+    sf::Time tick_{ sf::microseconds(1000000 / 60) };
+    /**
+     * Maximal number of updates in one iteration of game loop or 0 for no limit.
+     */
+    unsigned int maxTicks_{ 5 };
+    /**
+     * Number of updates after which game exits or 0 for no limit.
+     */
+    std::uint64_t tickLimit_{ 0 };
+    /**
+     * Number of updates since start of the game.
+     */
+    std::uint64_t ticks_{ 0 };
     /**
      * Active game state.
      */
     GameStatePtr state_;
     /**
-     * Determine if game should exit after this iteration.
+     * Determine if game should exit after this iteration (set by both threads).
      */
-    bool exit_{ false };
+    std::atomic<bool> exit_{ false };
+    /**
+     * Snapshots published by simulation thread to render thread.
+     */
+    TripleBuffer<RenderSnapshot> snapshots_;
+    Renderer renderer_;
+    /**
+     * Clock shared by both threads, snapshots are stamped by its time.
+     */
+    sf::Clock clock_;
 
     /**
      * Initialize the game.
      * 
      */
     void init();
+    /**
+     * Update game state without rendering as fast as possible.
+     * 
+     */
+    void runHeadless();
+    /**
+     * Update game state by fixed ticks and publish render snapshots until game exits (simulation thread).
+     * 
+     */
+    void simulate();
     /**
      * Update game's state.
      * 
@@ -67,11 +160,10 @@ private:
      */
     void update(const sf::Time& elapsed);
     /**
-     * Render the game.
+     * Render the latest published snapshot (render thread).
      * 
-     * \param elapsed Ellapsed time form last render.
      */
-    void render(const sf::Time& elapsed);
+    void render();
 };
 
 #endif
\ No newline at end of file
@@ -1,103 +1,203 @@
 #include "GameState.hpp"
+#include "CollisionTable.hpp"
 #include "Entity.hpp"
 #include "Entities.hpp"
+#include "Game.hpp"
+
+unsigned int GameState::lastSystemId_ = 0;
+
+GameState::GameState(Game* game) : game_(game), random_(game != nullptr ? game->getSeed() : 0) {}
+
+GameState::~GameState()
+{
+    // entities remove their transforms when destroyed, so they have to die before transform store
+    commands_.clear();
+    for (auto&& table : archetypes_)
+        table.clear();
+}
 
 void GameState::update(const sf::Time& elapsed)
 {
+    // whole microseconds, milliseconds would truncate 16.67 ms to 16 ms
+    float ms = elapsed.asMicroseconds() / 1000.f;
+
+    // move entities
+    transforms_.integrate(ms);
+    transforms_.updateBounds(ms);
+
+    // find collisions
+    detectCollisions(ms);
+
     // update entities
-    for (auto&& entity : entities_)
-        entity.second->update(elapsed);
+    for (auto&& system : systems_)
+    {
+        if (system != nullptr)
+            system->update(elapsed);
+    }
 
-    // remove netities
-    for (auto&& id : toRemove_)
+    applyCommands();
+}
+
+void GameState::detectCollisions(float ms)
+{
+    // entities with proxy are tested through their proxy, entities which are not added yet are skipped
+    auto makeBox = [](const Entity* entity, const Rectf& bounds, SweepAndPrune::Box& box)
     {
-        // ui entitiy
-        auto it = uiEntities_.find(id);
-        if (it != uiEntities_.end())
+        if (entity->getProxy() != nullptr || entity->getId() == EntityTable::invalid ||
+            (entity->getType() == EntityType::None && entity->getTargets() == EntityType::None))
+            return false;
+
+        box = SweepAndPrune::Box{ entity->getId(), entity->getType(), entity->getTargets(), bounds };
+        return true;
+    };
+    SweepAndPrune::Box inserted;
+
+    // awake entities are inserted every update
+    collisions_.clear();
+    for (unsigned int i = 0; i < transforms_.getAwake(); ++i)
+    {
+        if (makeBox(transforms_.getOwner(i), transforms_.getBounds(i), inserted))
+            collisions_.insert(inserted);
+    }
+
+    // sleeping entities only when some entity fell asleep, woke up, or a sleeping one was added or removed
+    if (staticChanged_ || sleepVersion_ != transforms_.getSleepVersion())
+    {
+        collisions_.clearStatic();
+        for (unsigned int i = (unsigned int)transforms_.getAwake(); i < transforms_.size(); ++i)
         {
-            uiEntities_[id]->onDead();
-            uiEntities_.erase(id);
-            continue;
+            if (makeBox(transforms_.getOwner(i), transforms_.getBounds(i), inserted))
+                collisions_.insertStatic(inserted);
+        }
+        staticChanged_ = false;
+        sleepVersion_ = transforms_.getSleepVersion();
+    }
+
+    const std::vector<SweepAndPrune::Pair>& pairs = collisions_.sweep();
+
+    // pairs are sorted by source, each source hits only the target with the earliest time of impact
+    for (std::size_t first = 0, last = 0; first < pairs.size(); first = last)
+    {
+        while (last < pairs.size() && pairs[last].source == pairs[first].source)
+            ++last;
+
+        Entity* source = getEntity(collisions_.getBox(pairs[first].source).id);
+        sf::Vector2f move = source->getSpeed() * ms;
+        Rectf start = source->getRigid();
+        start.left -= move.x;
+        start.top -= move.y;
+
+        Entity* hit = nullptr;
+        float hitTime = 0.f;
+        Rectf impact;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            // target moves too, so source is swept by movement relative to target's current position
+            Entity* target = getEntity(collisions_.getBox(pairs[i].target).id);
+            sf::Vector2f targetMove = target->getSpeed() * ms;
+            Rectf relative(start.left + targetMove.x, start.top + targetMove.y, start.width, start.height);
+
+            float time;
+            if (sweepTarget(target, relative, move - targetMove, time) && (hit == nullptr || time < hitTime))
+            {
+                hit = target;
+                hitTime = time;
+                impact = Rectf(relative.left + (move.x - targetMove.x) * time,
+                    relative.top + (move.y - targetMove.y) * time, relative.width, relative.height);
+
+                // nothing can be hit earlier
+                if (time == 0.f)
+                    break;
+            }
         }
 
+        if (hit != nullptr)
+            respondToCollision(*this, source, hit, impact);
+    }
+}
+
+void GameState::applyCommands()
+{
+    CommandBuffer::Batch& batch = commands_.take();
+
+    // remove netities
+    for (auto&& id : batch.despawns)
+    {
+        // entity was already removed
+        Entity* entity = getEntity(id);
+        if (entity == nullptr)
+            continue;
+
         // life bar
-        LBarPtr lifeBar = entities_[id]->getLifeBar();
+        LifeBar* lifeBar = entity->getLifeBar();
         if (lifeBar == nullptr)
         {
-            entities_[id]->onDead();
-            entities_.erase(id);
+            entity->onDead();
+            erase(id);
         }
         else
         {
             lifeBar->decreseCount();
             if (lifeBar->getCount() == 0)
             {
-                entities_[id]->onDead();
-                entities_[id]->setLifeBar(nullptr);
-                entities_.erase(id);
-                entities_.erase(lifeBar->getId());
+                entity->onDead();
+                entity->setLifeBar(nullptr);
+                erase(id);
+                erase(lifeBar->getId());
             }
             else
-                entities_[id]->respawn();
+                entity->respawn();
         }
     }
     // add entities
-    for (auto&& entity : toAdd_)
+    for (auto&& spawn : batch.spawns)
     {
-        if (static_cast<bool>(entity->getType() & EntityType::UI))
-            uiEntities_.insert(std::make_pair(entity->getId(), entity));
-        else
-            entities_.insert(std::make_pair(entity->getId(), entity));
-    }
+        Entity* entity = spawn.entity.get();
+        unsigned int archetype = getArchetype(entity->getType());
+        entity->id_ = (std::uint64_t(archetype) << handleBits_) | archetypes_[archetype].insert(std::move(spawn.entity));
+        spawn.attach(*this, entity);
 
-    toRemove_.clear();
-    toAdd_.clear();
+        // entity which fell asleep before it was added is missing in static boxes
+        if (entity->transform_ >= transforms_.getAwake())
+            staticChanged_ = true;
+    }
 }
 
-void GameState::render(const sf::Time& elapsed, sf::RenderWindow& window)
+void GameState::capture(RenderSnapshot& snapshot)
 {
-    for (auto&& entity : entities_)
-        entity.second->render(elapsed, window);
+    snapshot.clear();
 
-    for (auto&& entity : uiEntities_)
-        entity.second->render(elapsed, window);
+    // ui is rendered on top of other entities
+    auto capture = [&snapshot](Entity* entity) { entity->capture(snapshot); };
+    forEachWithout<EntityType::UI>(capture);
+    forEach<EntityType::UI>(capture);
 }
 
-void GameState::addEntity(EntityPtr entity) 
-{ 
-    toAdd_.push_back(entity);
-}
-
-void GameState::removeEntity(unsigned int index)
+void GameState::removeEntity(std::uint64_t index)
 {
-    toRemove_.push_back(index);
+    commands_.despawn(index);
 }
 
-std::vector<unsigned int> GameState::collision(unsigned int id, EntityType target) const
+Entity* GameState::getEntity(std::uint64_t id)
 {
-    std::vector<unsigned int> collided;
-    Rectf rect = entities_.find(id)->second->getRigid();
-
-    for (auto&& entity : entities_)
-    {
-        if (entity.first == id)
-            continue;
-
-        if (!static_cast<bool>(entity.second->getType() & target))
-            continue;
+    // e.g. id of entity which was not added yet (EntityTable::invalid)
+    if ((id >> handleBits_) >= archetypeCount_)
+        return nullptr;
 
-        if (rect.intersects(entity.second->getRigid()))
-            collided.push_back(entity.first);
-    }
-
-    return collided;
+    Owned<Entity>* entity = archetypes_[id >> handleBits_].find(id & handleMask_);
+    return entity != nullptr ? entity->get() : nullptr;
 }
 
-std::shared_ptr<Entity> GameState::getEntity(unsigned int id)
+void GameState::erase(std::uint64_t id)
 {
-    auto it = uiEntities_.find(id);
-    if (it != uiEntities_.end())
-        return uiEntities_[id];
-    else
-        return entities_[id];
+    if ((id >> handleBits_) >= archetypeCount_)
+        return;
+
+    Owned<Entity>* entity = archetypes_[id >> handleBits_].find(id & handleMask_);
+    if (entity == nullptr)
+        return;
+
+    if ((*entity)->system_ != nullptr)
+        (*entity)->system_->remove(entity->get());
+    archetypes_[id >> handleBits_].erase(id & handleMask_);
 }
\ No newline at end of file
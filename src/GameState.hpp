@@ -3,11 +3,22 @@
 
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <memory>
-#include <map>
+#include <memory_resource>
 #include <vector>
 #include <type_traits>
 
+#include "CommandBuffer.hpp"
+#include "Owned.hpp"
+#include "ProjectilePool.hpp"
+#include "Random.hpp"
+#include "RenderSnapshot.hpp"
+#include "SlotMap.hpp"
+#include "SweepAndPrune.hpp"
+#include "TransformStore.hpp"
+#include "UpdateSystem.hpp"
+
 /**
  * Represent a type of entity.
  */
@@ -18,9 +29,11 @@ enum class EntityType : unsigned int
     Structure = 0x2,
     Enemy = 0x4,
     UI = 0x8,
+    Projectile = 0x10,
+    Formation = 0x20,
 };
 
-inline EntityType operator | (EntityType left, EntityType right)
+constexpr EntityType operator | (EntityType left, EntityType right)
 {
     return static_cast<EntityType>(
         static_cast<std::underlying_type<EntityType>::type>(left) |
@@ -28,7 +41,7 @@ inline EntityType operator | (EntityType left, EntityType right)
     );
 }
 
-inline EntityType operator & (EntityType left, EntityType right)
+constexpr EntityType operator & (EntityType left, EntityType right)
 {
     return static_cast<EntityType>(
         static_cast<std::underlying_type<EntityType>::type>(left) &
@@ -40,13 +53,19 @@ class Entity;
 class Game;
 class ScoreBar;
 
+/**
+ * Table of entities which share the same type, 24 bits of handle are used for index and 32 for generation
+ * (removed entity's id becomes valid again only after 2^32 reuses of its slot).
+ */
+using EntityTable = SlotMap<Owned<Entity>, 24, 32>;
+
 /**
  * Represent a game state.
  */
 class GameState
 {
 public:
-    virtual ~GameState() {}
+    virtual ~GameState();
 
     /**
      * Initialize game state.
@@ -60,51 +79,250 @@ public:
      */
     virtual void update(const sf::Time& elapsed);
     /**
-     * Render game state.
+     * Capture game state to render snapshot after an update.
      * 
-     * \param elapsed Ellapsed time form last update.
-     * \param window Window used for rendering.
+     * \param snapshot Snapshot which is cleared and filled by all entities.
      */
-    virtual void render(const sf::Time& elapsed, sf::RenderWindow& window);
+    virtual void capture(RenderSnapshot& snapshot);
     /**
      * Add new entity to a game state.
+     * Entity has to be passed with its concrete type, which selects update system of the entity.
+     * Entity is added on the end of update (see CommandBuffer).
      * 
      * \param entity Entitiy to add.
      */
-    void addEntity(std::shared_ptr<Entity> entity);
+    template <typename T>
+    void addEntity(Owned<T> entity)
+    {
+        static_assert(!std::is_same<T, Entity>::value,
+            "Entity has to be added with its concrete type, so its update can be dispatched statically.");
+        commands_.spawn(CommandBuffer::Spawn{ std::move(entity), &GameState::attach<T> });
+    }
     /**
-     * Remove entity from a game state.
+     * Remove entity from a game state on the end of update, entity with a life bar
+     * loses one life and respawns instead.
+     * Entity removed several times in one update is removed (loses a life) only once,
+     * ids of entities which were already removed are ignored.
      * 
      * \param index Index of entitiy to remove.
      */
-    void removeEntity(unsigned int index);
+    void removeEntity(std::uint64_t index);
     
+    Game* getGame() { return game_; }
+    ScoreBar* getScoreBar() { return scoreBar_; }
     /**
-     * Check for collision between entitiy of speicifc id and all entities of specific type..
+     * Get entity with specific id.
      * 
-     * \param id Id of entitiy to check.
-     * \param target Type of all entitis to check.
-     * \return Vector which contains id of all collided entities (not a checked entitity).
+     * \return Entity or nullptr if entity with this id was removed or was not added yet.
      */
-    std::vector<unsigned int> collision(unsigned int id, EntityType target) const;
-    Game* getGame() { return game_; }
-    std::shared_ptr<ScoreBar> getScoreBar() { return scoreBar_; }
-    std::shared_ptr<Entity> getEntity(unsigned int id);
+    Entity* getEntity(std::uint64_t id);
+    /**
+     * Get positions, speeds and sizes of all entities which belong to game state.
+     * 
+     */
+    TransformStore& getTransforms() { return transforms_; }
+    /**
+     * Get pool used for creating projectiles.
+     * 
+     */
+    ProjectilePool& getProjectiles() { return projectiles_; }
+    /**
+     * Get random stream of a subsystem, all streams are derived from seed of the game (see Game::getSeed).
+     * 
+     */
+    Random& getRandom(RandomStream stream) { return random_.get(stream); }
+    /**
+     * Get memory resource of game state, all memory taken from it is released at once
+     * when game state is destroyed.
+     * 
+     */
+    std::pmr::memory_resource* getMemory() { return &memory_; }
+    /**
+     * Create object (entity or sprite) in the memory of game state.
+     * 
+     * \param args Arguments passed to constructor of T.
+     */
+    template <typename T, typename... Args>
+    Owned<T> make(Args&&... args)
+    {
+        return create<T>(&memory_, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Call function for each entity whose type has at least one of the bits of Mask.
+     * Only archetype tables which match the mask are visited, forEach<EntityType::None>
+     * visits only entities without a type.
+     * 
+     * \param function Function called with Entity* of each entity.
+     */
+    template <EntityType Mask, typename Function>
+    void forEach(Function&& function)
+    {
+        for (unsigned int archetype = 0; archetype < archetypeCount_; ++archetype)
+        {
+            if (matches(archetype, Mask))
+            {
+                for (auto&& entity : archetypes_[archetype])
+                    function(entity.get());
+            }
+        }
+    }
+    /**
+     * Call function for each entity whose type has at least one of the bits of mask.
+     * Runtime version of forEach<Mask>.
+     * 
+     */
+    template <typename Function>
+    void forEach(EntityType mask, Function&& function) const
+    {
+        for (unsigned int archetype = 0; archetype < archetypeCount_; ++archetype)
+        {
+            if (matches(archetype, mask))
+            {
+                for (auto&& entity : archetypes_[archetype])
+                    function(entity.get());
+            }
+        }
+    }
+    /**
+     * Call function for each entity whose type has none of the bits of Mask.
+     * 
+     */
+    template <EntityType Mask, typename Function>
+    void forEachWithout(Function&& function)
+    {
+        for (unsigned int archetype = 0; archetype < archetypeCount_; ++archetype)
+        {
+            if ((archetype & static_cast<unsigned int>(Mask)) == 0)
+            {
+                for (auto&& entity : archetypes_[archetype])
+                    function(entity.get());
+            }
+        }
+    }
 protected:
-    GameState(Game* game) : game_(game) {}
-    std::shared_ptr<ScoreBar> scoreBar_;
+    GameState(Game* game);
+    /**
+     * Score bar of game state (owned by game state as any other entity).
+     */
+    ScoreBar* scoreBar_{ nullptr };
 private:
-    std::map<unsigned int, std::shared_ptr<Entity>> entities_;
-    std::map<unsigned int, std::shared_ptr<Entity>> uiEntities_;
     /**
-     * Contains id of all entities which will be removed on the end of iteration.
+     * Arena which holds memory of all entities and sprites in a few large blocks.
      */
-    std::vector<unsigned int> toRemove_;
+    std::pmr::monotonic_buffer_resource arena_{ 64 * 1024 };
     /**
-     * Contains all entities which will be added next iteration.
+     * Recycles memory of destroyed entities and sprites inside the arena.
      */
-    std::vector<std::shared_ptr<Entity>> toAdd_;
+    std::pmr::unsynchronized_pool_resource memory_{ &arena_ };
+    /**
+     * Contains positions, speeds and sizes of all entities.
+     */
+    TransformStore transforms_;
+    /**
+     * Contains memory of projectiles, has to outlive all entities.
+     */
+    ProjectilePool projectiles_{ 128, &memory_ };
+    /**
+     * Number of bits of entity id used for handle to archetype table, rest is used for archetype.
+     */
+    static constexpr unsigned int handleBits_ = 56;
+    static constexpr std::uint64_t handleMask_ = (std::uint64_t(1) << handleBits_) - 1;
+    /**
+     * Number of all possible combinations of EntityType bits.
+     */
+    static constexpr unsigned int archetypeCount_ = 64;
+
+    /**
+     * Contains entities grouped by their type (archetype table for each combination of EntityType bits).
+     * Entity's id is archetype in the high bits and handle to archetype table in the low bits.
+     */
+    EntityTable archetypes_[archetypeCount_];
+    /**
+     * Finds colliding pairs of entities once per update.
+     */
+    SweepAndPrune collisions_;
+    /**
+     * Sleep version of transform store when static boxes were inserted to collisions_.
+     */
+    unsigned int sleepVersion_{ 0 };
+    /**
+     * Determine if sleeping entities were added since static boxes were inserted to collisions_
+     * (removed sleeping transforms change sleep version).
+     */
+    bool staticChanged_{ true };
+    /**
+     * Contains spawns and despawns which will be applied on the end of update.
+     */
+    CommandBuffer commands_;
+    /**
+     * Contains update system for each concrete entity type which overrides Entity::update.
+     * Indexed by getSystemId<T>.
+     */
+    std::vector<std::unique_ptr<IUpdateSystem>> systems_;
+    /**
+     * Used for generating system ids.
+     */
+    static unsigned int lastSystemId_;
     Game* game_;
+    RandomService random_;
+
+    /**
+     * Add entity to update system of type T, entities which do not override Entity::update
+     * do not belong to any system.
+     * 
+     */
+    template <typename T>
+    static void attach(GameState& state, Entity* entity)
+    {
+        using Update = void (Entity::*)(const sf::Time&);
+        if (std::is_same<decltype(&T::update), Update>::value)
+            return;
+
+        unsigned int id = getSystemId<T>();
+        if (id >= state.systems_.size())
+            state.systems_.resize(id + 1);
+        if (state.systems_[id] == nullptr)
+            state.systems_[id] = std::make_unique<UpdateSystem<T>>();
+
+        static_cast<UpdateSystem<T>*>(state.systems_[id].get())->add(static_cast<T*>(entity));
+    }
+    /**
+     * Get unique id of update system for entity type T.
+     * 
+     */
+    template <typename T>
+    static unsigned int getSystemId()
+    {
+        static const unsigned int id = lastSystemId_++;
+        return id;
+    }
+    /**
+     * Find all collisions of entities with their targets and apply their responses (see CollisionTable).
+     * Candidates are found from bounds of whole movement, hit is the target with the earliest time of impact.
+     * 
+     * \param ms Ellapsed time in ms of this update.
+     */
+    void detectCollisions(float ms);
+    /**
+     * Apply all recorded spawns and despawns in one pass.
+     * 
+     */
+    void applyCommands();
+    /**
+     * Remove entity from its archetype table immediately.
+     * 
+     */
+    void erase(std::uint64_t id);
+
+    static constexpr unsigned int getArchetype(EntityType type)
+    {
+        return static_cast<unsigned int>(type) & (archetypeCount_ - 1);
+    }
+    static constexpr bool matches(unsigned int archetype, EntityType mask)
+    {
+        return mask == EntityType::None ? archetype == 0 : (archetype & static_cast<unsigned int>(mask)) != 0;
+    }
 };
 
 using GameStatePtr = std::shared_ptr<GameState>;
@@ -1,14 +1,20 @@
 #include "LevelState.hpp"
 #include "../Entities.hpp"
+#include "../FontManager.hpp"
 #include "../Game.hpp"
 
+#include <cmath>
 #include <ios>
 #include <memory>
 
+const sf::Vector2f LevelState::ufoSize_(45.f, 20.f);
+
 void LevelState::init()
 {
     // Load sprite sheet which contains textures for all entites.
-    TextureManager::getInstance().load("Content/Textures/invaders.png", "invaders");
+    TextureId invaders = TextureManager::getInstance().load("Content/Textures/invaders.png", "invaders");
+    loadClips(invaders);
+    needed_ = drawUfoDelay();
 
     generatePlayer();
     generateCluster();
@@ -19,29 +25,56 @@ void LevelState::update(const sf::Time& elapsed)
 {
     GameState::update(elapsed);
 
-    elapsed_ += elapsed.asMilliseconds();
+    // check for game over
+    if (formation_->getLive() == 0)
+    {
+        getGame()->gameOver("Game over!\nYou win.");
+        return;
+    }
+
+    elapsed_ += elapsed.asMicroseconds() / 1000.f;
     if (elapsed_ >= needed_)
     {
         elapsed_ -= needed_;
+        needed_ = drawUfoDelay();
         spawnUfo();
     }
 }
 
+void LevelState::loadClips(TextureId texture)
+{
+    AnimationManager& clips = AnimationManager::getInstance();
+
+    // frames of enemies (one clip per row type)
+    enemyClips_[0] = clips.add(texture, { sf::IntRect(40, 30, 64, 64), sf::IntRect(142, 31, 64, 64) });
+    enemyClips_[1] = clips.add(texture, { sf::IntRect(27, 134, 88, 64), sf::IntRect(131, 134, 88, 64) });
+    enemyClips_[2] = clips.add(texture, { sf::IntRect(14, 241, 96, 64), sf::IntRect(128, 242, 96, 64) });
+
+    // frame of ufo
+    ufoClip_ = clips.add(texture, { sf::IntRect(30, 338, 192, 84) });
+
+    // collision masks scaled to size of sprites on screen
+    unsigned int enemy = (unsigned int)std::lround(enemySize_ * enemyScale_);
+    for (ClipId clip : enemyClips_)
+        clips.buildMasks(clip, sf::Vector2u(enemy, enemy));
+    clips.buildMasks(ufoClip_, sf::Vector2u((unsigned int)ufoSize_.x, (unsigned int)ufoSize_.y));
+}
+
 void LevelState::spawnUfo()
 {
     if (Ufo::spawned)
         return;
     
     sf::Vector2f pos(800.f, 70.f);
-    sf::Vector2f size(45.f, 20.f);
-
-    std::vector<sf::IntRect> frames;
-    frames.emplace_back(30, 338, 192, 84);
+    sf::Vector2f size = ufoSize_;
 
-    IRenderPtr sprite = std::make_shared<ImageSprite>(pos, size, "invaders", frames);
-    EntityPtr ufo = std::make_shared<Ufo>(this, sprite, -.2f);
+    ImageSprite sprite(pos, size, ufoClip_);
+    addEntity(make<Ufo>(this, std::move(sprite), -.2f));
+}
 
-    addEntity(ufo);
+float LevelState::drawUfoDelay()
+{
+    return ufoMinDelay_ + (ufoMaxDelay_ - ufoMinDelay_) * getRandom(RandomStream::Ufo).nextFloat();
 }
 
 void LevelState::generatePlayer()
@@ -50,28 +83,26 @@ void LevelState::generatePlayer()
     sf::Vector2f pos(400.f, 570.f);
     sf::Vector2f size(60.f, 18.f);
 
-    IRenderPtr sprite = std::make_shared<RectSprite>(pos, size, sf::Color::Green);
-    EntityPtr player = std::make_shared<Player>(this, sprite);
+    Owned<Player> player = make<Player>(this, RectSprite(pos, size, sf::Color::Green));
 
     // create life bar
     pos = sf::Vector2f(660.f, 20.f);
     size = size * .7f;
 
-    IRenderPtr spriteLife = std::make_shared<RectSprite>(pos, size, sf::Color::Green);
-    LBarPtr lifeBar = std::make_shared<LifeBar>(this, spriteLife, 3);
-    player->setLifeBar(lifeBar);
+    Owned<LifeBar> lifeBar = make<LifeBar>(this, RectSprite(pos, size, sf::Color::Green), 3);
+    player->setLifeBar(lifeBar.get());
 
     // create score bar
-    sf::Font font;
-    if (!font.loadFromFile("Content/Fonts/ARCADE.TTF"))
+    if (!FontManager::getInstance().load("Content/Fonts/ARCADE.TTF", "arcade"))
         throw std::ios_base::failure("Cannot load font!");
-    TextPtr textSprite = std::make_shared<TextSprite>(sf::Vector2f(5.f, 0.f), font, "", 60, sf::Color::Yellow);
-    scoreBar_ = std::make_shared<ScoreBar>(this, textSprite);
+    TextSprite textSprite(sf::Vector2f(5.f, 0.f), FontManager::getInstance().get("arcade"), "", 60, sf::Color::Yellow);
+    Owned<ScoreBar> scoreBar = make<ScoreBar>(this, std::move(textSprite));
+    scoreBar_ = scoreBar.get();
 
     // add entities
-    addEntity(player);
-    addEntity(lifeBar);
-    addEntity(scoreBar_);
+    addEntity(std::move(player));
+    addEntity(std::move(lifeBar));
+    addEntity(std::move(scoreBar));
 }
 
 void LevelState::generateCluster()
@@ -79,24 +110,12 @@ void LevelState::generateCluster()
     // constants 
     constexpr int countX = 11, countY = 5;
     constexpr float startY = 100.f;
-    constexpr  float enemySize = 40.f;
+    constexpr float enemySize = enemySize_;
     constexpr float distance = 800.f - countX * enemySize;
-    constexpr float sizeScale = .7f;
-
-    // init frames for animation
-    std::vector<sf::IntRect> enemyType1;
-    enemyType1.emplace_back(40, 30, 64, 64);
-    enemyType1.emplace_back(142, 31, 64, 64);
-
-    std::vector<sf::IntRect> enemyType2;
-    enemyType2.emplace_back(27, 134, 88, 64);
-    enemyType2.emplace_back(131, 134, 88, 64);
-
-    std::vector<sf::IntRect> enemyType3;
-    enemyType3.emplace_back(14, 241, 96, 64);
-    enemyType3.emplace_back(128, 242, 96, 64);
+    constexpr float sizeScale = enemyScale_;
 
     // create grid of enemy entities (alien cluster)
+    Owned<Formation> formation = make<Formation>(this, countX, countY, sf::Vector2f(enemySize, enemySize), distance);
     for (int x = 0; x < countX; x++)
     {
         for (int y = 0; y < countY; y++)
@@ -104,11 +123,15 @@ void LevelState::generateCluster()
             sf::Vector2f pos(enemySize / 2 + x * enemySize, startY + y * enemySize);
             sf::Vector2f size(enemySize * sizeScale, enemySize * sizeScale);
 
-            std::shared_ptr<ImageSprite> sprite = std::make_shared<ImageSprite>(pos, size, "invaders", (y == 0 ? enemyType1 : (y >= 3 ? enemyType3 : enemyType2)));
-            addEntity(std::make_shared<Enemy>(this, sprite, distance));
+            ImageSprite sprite(pos, size, enemyClips_[y == 0 ? 0 : (y >= 3 ? 2 : 1)]);
+            Owned<Enemy> enemy = make<Enemy>(this, std::move(sprite));
+            formation->add(x, y, enemy.get());
+            addEntity(std::move(enemy));
         }
     }
-    clusterSize_ = countX * countY;
+    formation->refresh();
+    formation_ = formation.get();
+    addEntity(std::move(formation));
 }
 
 void LevelState::generateHouses()
@@ -127,33 +150,17 @@ void LevelState::generateHouses()
 void LevelState::generateHouse(float startX, float startY)
 {
     // constants
-    constexpr float blockSize = 10.f;
-    constexpr float roofWidth = 100.f;
-    constexpr float roofHeight = 30.f;
-    constexpr float wallWidth = 20.f;
-    constexpr float wallHeight = 30.f;
-
-    // create roof
-    generateRectangle(startX, startY, roofWidth, roofHeight, blockSize);
-
-    // create walls
-    generateRectangle(startX, startY + roofHeight, wallWidth, wallHeight, blockSize);
-    generateRectangle(startX + roofWidth - wallWidth, startY + roofHeight, wallWidth,
-     wallHeight, blockSize);
-}
-
-void LevelState::generateRectangle(float startX, float startY, float width, float height,
- float blockSize)
-{
-    for (int y = 0; y < (int)(height / blockSize); y++)
-    {
-        for (int x = 0; x < (int)(width / blockSize); x++)
-        {
-            sf::Vector2f pos(startX + x * blockSize, startY + y * blockSize);
-            sf::Vector2f size(blockSize, blockSize);
-
-            IRenderPtr sprite = std::make_shared<RectSprite>(pos, size, sf::Color::Green);
-            addEntity(std::make_shared<Block>(this, sprite));
-        }
-    }
+    constexpr unsigned int roofWidth = 100;
+    constexpr unsigned int roofHeight = 30;
+    constexpr unsigned int wallWidth = 20;
+    constexpr unsigned int wallHeight = 30;
+
+    // create bunker covering roof and walls
+    sf::Vector2u size(roofWidth, roofHeight + wallHeight);
+    sf::Vector2f pos(startX + size.x / 2.f, startY + size.y / 2.f);
+    Owned<Bunker> bunker = make<Bunker>(this, pos, size);
+
+    // cut out space between walls
+    bunker->erase(sf::IntRect(wallWidth, roofHeight, roofWidth - 2 * wallWidth, wallHeight));
+    addEntity(std::move(bunker));
 }
\ No newline at end of file
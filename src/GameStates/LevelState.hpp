@@ -1,8 +1,11 @@
 #ifndef LEVELSTATE_HPP
 #define LEVELSTATE_HPP
 
+#include "../AnimationManager.hpp"
 #include "../GameState.hpp"
 
+class Formation;
+
 /**
  * Represent a level game state.
  */
@@ -14,25 +17,55 @@ public:
     void init() override;
     void update(const sf::Time& elapsed) override;
 private:
-    friend class Enemy;
     /**
      * Ellapsed time in ms from last ufo spawn.
      */
     float elapsed_{ 0 };
     /**
-     * Time needed in ms for ufo to be spawned (ufo will spawn each needed_ ms).
+     * Time needed in ms for ufo to be spawned, drawn from ufo's random stream after each spawn.
      */
     float needed_ { 30000.f };
     /**
-     * Number of enemis in alien cluster.
+     * Range of times between ufo spawns in ms.
+     */
+    static constexpr float ufoMinDelay_ = 20000.f;
+    static constexpr float ufoMaxDelay_ = 40000.f;
+    /**
+     * Formation of enemies in alien cluster (owned by game state).
+     */
+    Formation* formation_{ nullptr };
+    /**
+     * Animation clips of enemies (one for each row type) and ufo.
      */
-    int clusterSize_{ 0 };
+    ClipId enemyClips_[3]{};
+    ClipId ufoClip_{ 0 };
+    /**
+     * Space of one enemy in alien cluster and scale of enemy sprite in this space.
+     */
+    static constexpr float enemySize_ = 40.f;
+    static constexpr float enemyScale_ = .7f;
+    /**
+     * Size of ufo sprite.
+     */
+    static const sf::Vector2f ufoSize_;
+
+    /**
+     * Register animation clips of entities in animation manager.
+     * 
+     * \param texture Sprite sheet which contains frames of all clips.
+     */
+    void loadClips(TextureId texture);
 
     /**
      * Spawn ufo.
      * 
      */
     void spawnUfo();
+    /**
+     * Draw time in ms to the next ufo spawn.
+     * 
+     */
+    float drawUfoDelay();
     /**
      * Create player entity and his life and score bar.
      * 
@@ -55,17 +88,6 @@ private:
      * \param startY Y coor of top-left corner of house location.
      */
     void generateHouse(float startX, float startY);
-    /**
-     * Create rectangle out of Block entities.
-     * 
-     * \param startX X coor of top-left corner of rectangle location.
-     * \param startY Y coor of top-left corner of rectangle location.
-     * \param width Width of the rectangle.
-     * \param height Height of the rectangle.
-     * \param blockSize Size of each block entitiy.
-     */
-    void generateRectangle(float startX, float startY, float width, float height,
-     float blockSize);
 };
 
 #endif // !LEVELSTATE_HPP
\ No newline at end of file
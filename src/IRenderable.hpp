@@ -2,13 +2,17 @@
 #define SPRITE_HPP
 
 #include <SFML/Graphics.hpp>
-#include <memory>
+#include <variant>
 #include <vector>
 
-#include "TextureManager.hpp"
+#include "AnimationManager.hpp"
+#include "RenderSnapshot.hpp"
 
 /**
- * Represent an abstract class for sprite.
+ * Represent a base class for sprite.
+ * Sprites are stored by value inside their entity (see Sprite), so they have no
+ * virtual methods, each sprite class has its own non-virtual capture method which adds
+ * the sprite to render snapshot (see Renderer).
  */
 class IRenderable
 {
@@ -21,14 +25,6 @@ public:
      */
     IRenderable(sf::Vector2f pos, sf::Vector2f size)
         : pos_(pos), size_(size) {}
-    virtual ~IRenderable() {}
-
-    /**
-     * Render sprite to window.
-     * 
-     * \param window WIndow to which will be sprite rendered.
-     */
-    virtual void render(sf::RenderWindow& window) const = 0;
 
     /**
      * Set position of sprite.
@@ -55,8 +51,6 @@ protected:
     sf::Vector2f size_;
 };
 
-using IRenderPtr = std::shared_ptr<IRenderable>;
-
 /**
  * Represent a image sprite.
  */
@@ -68,22 +62,31 @@ public:
      * 
      * \param pos Position of sprite.
      * \param size Size of sprite.
-     * \param name Name of the texture which will sprite use.
-     * \param rects Frames used for sprite's animation (rectangles form sprite sheet).
+     * \param clip Animation clip which will sprite play (see AnimationManager).
      */
-    ImageSprite(sf::Vector2f pos, sf::Vector2f size, const std::string& name, std::vector<sf::IntRect> rects)
-        : IRenderable{ pos, size }, rects_{rects}, name_(name) {}
+    ImageSprite(sf::Vector2f pos, sf::Vector2f size, ClipId clip)
+        : IRenderable{ pos, size }, clip_(clip) {}
+
+    /**
+     * Capture sprite to render snapshot.
+     * 
+     * \param snapshot Snapshot to which will be sprite added.
+     * \param prev Position of sprite before the last update.
+     */
+    void capture(RenderSnapshot& snapshot, sf::Vector2f prev) const
+    {
+        snapshot.addImage(prev, pos_, size_, clip_, current_);
+    }
 
-    void render(sf::RenderWindow& window) const override
+    /**
+     * Get collision mask of current frame.
+     * 
+     * \return Mask or nullptr if clip has no masks.
+     */
+    const Bitmap* getMask() const
     {
-        sf::Sprite sprite;
-        sprite.setTexture(TextureManager::getInstance().get(name_));
-        sprite.setTextureRect(rects_[current_]);
-        sprite.setOrigin(sf::Vector2f((float)rects_[current_].width, (float)rects_[current_].height) / 2.f);
-        sprite.setPosition(pos_);
-        sprite.setScale(size_.x / rects_[current_].width, size_.y / rects_[current_].height);
-
-        window.draw(sprite);
+        const AnimationClip& clip = AnimationManager::getInstance().get(clip_);
+        return clip.masks.empty() ? nullptr : &clip.masks[current_];
     }
 
     /**
@@ -93,23 +96,19 @@ public:
     void NextFrame()
     {
         current_++;
-        if (current_ == rects_.size())
+        if (current_ == AnimationManager::getInstance().get(clip_).frames.size())
             current_ = 0;
     }
 
 private:
     /**
-     * Name of texture.
+     * Played animation clip, frames are shared by all sprites playing the clip.
      */
-    std::string name_;
-    /**
-     * Contains frames used for animation.
-     */
-    std::vector<sf::IntRect> rects_;
+    ClipId clip_;
     /**
      * Index of current frame.
      */
-    std::size_t current_{ 0 };
+    unsigned int current_{ 0 };
 };
 
 /**
@@ -128,15 +127,9 @@ public:
     RectSprite(sf::Vector2f pos, sf::Vector2f size, sf::Color col)
         : IRenderable{pos, size}, col_(col) {}
 
-    void render(sf::RenderWindow& window) const override
+    void capture(RenderSnapshot& snapshot, sf::Vector2f prev) const
     {
-        sf::RectangleShape shape;
-        shape.setSize(size_);
-        shape.setOrigin(size_ / 2.f);
-        shape.setPosition(pos_);
-        shape.setFillColor(col_);
-
-        window.draw(shape);
+        snapshot.addRect(prev, pos_, size_, col_);
     }
 private:
     sf::Color col_;
@@ -152,26 +145,23 @@ public:
      * Create new text sprite.
      * 
      * \param pos Position of sprite.
-     * \param font Font whoch sprite's use.
+     * \param font Font whoch sprite's use (has to outlive the sprite, see FontManager).
      * \param string Text which will be displayed.
      * \param charSize Size of characters.
      * \param col Color of text.
      */
     TextSprite(sf::Vector2f pos , const sf::Font& font, const std::string& string,
         int charSize, sf::Color col)
-        : IRenderable{pos, sf::Vector2f()}, font_(font), string_(string),
+        : IRenderable{pos, sf::Vector2f()}, font_(&font), string_(string),
         charSize_(charSize), col_(col) {}
 
-    void render(sf::RenderWindow& window) const override
+    /**
+     * Capture sprite to render snapshot, text is not interpolated.
+     * 
+     */
+    void capture(RenderSnapshot& snapshot, sf::Vector2f prev) const
     {
-        sf::Text text;
-        text.setPosition(pos_);
-        text.setFont(font_);
-        text.setString(string_);
-        text.setCharacterSize(charSize_);
-        text.setFillColor(col_);
-
-        window.draw(text);
+        snapshot.addText(pos_, font_, string_, charSize_, col_);
     }
 
     /**
@@ -189,7 +179,7 @@ private:
     /**
      * Font of text.
      */
-    sf::Font font_;
+    const sf::Font* font_;
     /**
      * Display text.
      */
@@ -204,6 +194,9 @@ private:
     sf::Color col_;
 };
 
-using TextPtr = std::shared_ptr<TextSprite>;
+/**
+ * Represent a sprite of any kind, stored inline in its entity.
+ */
+using Sprite = std::variant<RectSprite, ImageSprite, TextSprite>;
 
 #endif // !SPRITE_HPP
\ No newline at end of file
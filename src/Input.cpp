@@ -0,0 +1,59 @@
+#include "Input.hpp"
+
+#include <SFML/Window/Keyboard.hpp>
+#include <fstream>
+#include <ios>
+#include <sstream>
+
+bool KeyboardInput::isPressed(Action action) const
+{
+    switch (action)
+    {
+        case Action::Left:
+            return sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+        case Action::Right:
+            return sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+        case Action::Fire:
+            return sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    }
+
+    return false;
+}
+
+ScriptedInput::ScriptedInput(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::ios_base::failure("Cannot load input script!");
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        Step step;
+        std::string keys;
+        if (line.empty() || line[0] == '#' || !(stream >> step.tick >> keys))
+            continue;
+
+        step.actions = 0;
+        for (char key : keys)
+        {
+            if (key == 'L')
+                step.actions |= static_cast<unsigned int>(Action::Left);
+            else if (key == 'R')
+                step.actions |= static_cast<unsigned int>(Action::Right);
+            else if (key == 'F')
+                step.actions |= static_cast<unsigned int>(Action::Fire);
+        }
+        steps_.push_back(step);
+    }
+}
+
+void ScriptedInput::update()
+{
+    // apply all steps which start at this update
+    while (next_ < steps_.size() && steps_[next_].tick <= tick_)
+        actions_ = steps_[next_++].actions;
+
+    tick_++;
+}
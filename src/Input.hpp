@@ -0,0 +1,100 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Represent an action of player.
+ */
+enum class Action : unsigned int
+{
+    Left = 0x1,
+    Right = 0x2,
+    Fire = 0x4,
+};
+
+/**
+ * Represent a source of player's actions, game reads it once per update.
+ */
+class IInput
+{
+public:
+    virtual ~IInput() {}
+
+    /**
+     * Advance input to the next update.
+     * 
+     */
+    virtual void update() {}
+    /**
+     * Determine if action is active during current update.
+     * 
+     */
+    virtual bool isPressed(Action action) const = 0;
+};
+
+/**
+ * Represent an input read from keyboard (needs a window system).
+ */
+class KeyboardInput final : public IInput
+{
+public:
+    bool isPressed(Action action) const override;
+};
+
+/**
+ * Represent an input with no active action.
+ */
+class NullInput final : public IInput
+{
+public:
+    bool isPressed(Action action) const override { return false; }
+};
+
+/**
+ * Represent an input replayed from a script.
+ * Each line of script contains an update number and actions active from this update
+ * to the next line (L - left, R - right, F - fire, - no action), e.g. "120 LF".
+ * Lines have to be sorted by update number, lines starting with # are ignored.
+ */
+class ScriptedInput final : public IInput
+{
+public:
+    /**
+     * Load script from file.
+     * 
+     * \param path Path to the script.
+     */
+    explicit ScriptedInput(const std::string& path);
+
+    void update() override;
+    bool isPressed(Action action) const override
+    {
+        return (actions_ & static_cast<unsigned int>(action)) != 0;
+    }
+private:
+    struct Step
+    {
+        std::uint64_t tick;
+        unsigned int actions;
+    };
+
+    std::vector<Step> steps_;
+    /**
+     * Next step of script which was not applied yet.
+     */
+    std::size_t next_{ 0 };
+    /**
+     * Number of current update.
+     */
+    std::uint64_t tick_{ 0 };
+    /**
+     * Actions active during current update.
+     */
+    unsigned int actions_{ 0 };
+};
+
+#endif // !INPUT_HPP
@@ -1,24 +1,101 @@
 #include "Game.hpp"
 #include "GameStates/LevelState.hpp"
 
+#include <charconv>
+#include <cstring>
 #include <memory>
-#include <cstdlib>
+#include <cstdint>
 #include <ctime>
+#include <string>
 
 #include <iostream>
+#include <stdexcept>
 
-int main()
+/**
+ * Print command line options.
+ * 
+ */
+static void printUsage(const char* program)
 {
-    // create seed used for generation of random numbers
-    srand((unsigned)time(0));
+    std::cerr << "Usage: " << program << " [--seed <number>] [--headless] [--ticks <number>] [--input <path>]"
+        << std::endl;
+}
+
+/**
+ * Parse whole argument as a decimal number without sign.
+ * 
+ * \throw std::invalid_argument If argument is not a number (e.g. "-1" or "12abc").
+ * \throw std::out_of_range If number does not fit to 64 bits.
+ */
+static std::uint64_t parseNumber(const char* text)
+{
+    std::uint64_t value = 0;
+    const char* end = text + std::strlen(text);
+    std::from_chars_result result = std::from_chars(text, end, value);
+    if (result.ec == std::errc::result_out_of_range)
+        throw std::out_of_range(text);
+    if (result.ec != std::errc() || result.ptr != end)
+        throw std::invalid_argument(text);
+
+    return value;
+}
+
+int main(int argc, char* argv[])
+{
+    // command line:
+    // --seed <number> seed of random streams (replays a game)
+    // --headless run without window as fast as possible
+    // --ticks <number> exit after number of updates
+    // --input <path> replay player's actions from script (see ScriptedInput)
+    std::uint64_t seed = (std::uint64_t)time(0);
+    bool headless = false;
+    std::uint64_t ticks = 0;
+    std::string script;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg(argv[i]);
+            if (arg == "--headless")
+                headless = true;
+            else if (i + 1 < argc && arg == "--seed")
+                seed = parseNumber(argv[++i]);
+            else if (i + 1 < argc && arg == "--ticks")
+                ticks = parseNumber(argv[++i]);
+            else if (i + 1 < argc && arg == "--input")
+                script = argv[++i];
+            else
+                throw std::invalid_argument(arg);
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        // invalid or out of range number, unknown option or option without value
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::cout << "Seed: " << seed << std::endl;
 
     // create game and game state
-    Game game(sf::Vector2u(800, 600), "Space Invaders");
+    Game game(sf::Vector2u(800, 600), "Space Invaders", seed, headless);
+    game.setTickLimit(ticks);
+    if (!script.empty())
+    {
+        try
+        {
+            game.setInput(std::make_unique<ScriptedInput>(script));
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << exception.what() << std::endl;
+            return 1;
+        }
+    }
     GameStatePtr state = std::make_shared<LevelState>(&game);
 
     // set game state and launch the game
     game.setState(state);
     game.run();
-    
+
     return 0;
-}
\ No newline at end of file
+}
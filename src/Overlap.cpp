@@ -0,0 +1,108 @@
+#include "Overlap.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OVERLAP_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OVERLAP_SSE
+#endif
+
+unsigned int overlapMask(const float* minX, const float* minY, const float* maxX, const float* maxY,
+    std::size_t count, const sf::FloatRect& rect)
+{
+    // tails are tested by scalar code, loads would read behind the arrays
+    if (count < overlapWidth)
+        return overlapMaskScalar(minX, minY, maxX, maxY, count, rect);
+
+#if defined(OVERLAP_AVX)
+    __m256 left = _mm256_set1_ps(rect.left);
+    __m256 top = _mm256_set1_ps(rect.top);
+    __m256 right = _mm256_set1_ps(rect.left + rect.width);
+    __m256 bottom = _mm256_set1_ps(rect.top + rect.height);
+
+    __m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX), right, _CMP_LT_OQ),
+        _mm256_cmp_ps(left, _mm256_loadu_ps(maxX), _CMP_LT_OQ));
+    __m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY), bottom, _CMP_LT_OQ),
+        _mm256_cmp_ps(top, _mm256_loadu_ps(maxY), _CMP_LT_OQ));
+
+    return (unsigned int)_mm256_movemask_ps(_mm256_and_ps(x, y));
+#elif defined(OVERLAP_SSE)
+    __m128 left = _mm_set1_ps(rect.left);
+    __m128 top = _mm_set1_ps(rect.top);
+    __m128 right = _mm_set1_ps(rect.left + rect.width);
+    __m128 bottom = _mm_set1_ps(rect.top + rect.height);
+
+    unsigned int mask = 0;
+    for (std::size_t i = 0; i < overlapWidth; i += 4)
+    {
+        __m128 x = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minX + i), right), _mm_cmplt_ps(left, _mm_loadu_ps(maxX + i)));
+        __m128 y = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + i), bottom), _mm_cmplt_ps(top, _mm_loadu_ps(maxY + i)));
+        mask |= (unsigned int)_mm_movemask_ps(_mm_and_ps(x, y)) << i;
+    }
+
+    return mask;
+#else
+    return overlapMaskScalar(minX, minY, maxX, maxY, count, rect);
+#endif
+}
+
+unsigned int overlapMaskScalar(const float* minX, const float* minY, const float* maxX, const float* maxY,
+    std::size_t count, const sf::FloatRect& rect)
+{
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+
+    unsigned int mask = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (minX[i] < right && rect.left < maxX[i] && minY[i] < bottom && rect.top < maxY[i])
+            mask |= 1u << i;
+    }
+
+    return mask;
+}
+
+namespace
+{
+    /**
+     * Compute interval of movement in which box overlaps target along one axis.
+     *
+     * \return False if box never overlaps target along the axis.
+     */
+    bool sweepAxis(float min, float max, float move, float targetMin, float targetMax, float& enter, float& exit)
+    {
+        if (move == 0.f)
+        {
+            enter = -std::numeric_limits<float>::infinity();
+            exit = std::numeric_limits<float>::infinity();
+            return min < targetMax && targetMin < max;
+        }
+
+        float first = (targetMin - max) / move;
+        float second = (targetMax - min) / move;
+        enter = std::min(first, second);
+        exit = std::max(first, second);
+        return true;
+    }
+}
+
+bool sweepBox(const sf::FloatRect& box, sf::Vector2f move, const sf::FloatRect& target, float& time)
+{
+    float enterX, exitX, enterY, exitY;
+    if (!sweepAxis(box.left, box.left + box.width, move.x, target.left, target.left + target.width, enterX, exitX) ||
+        !sweepAxis(box.top, box.top + box.height, move.y, target.top, target.top + target.height, enterY, exitY))
+        return false;
+
+    // box overlaps target only when it overlaps along both axes
+    float enter = std::max(enterX, enterY);
+    float exit = std::min(exitX, exitY);
+    if (enter >= exit || enter > 1.f || exit <= 0.f)
+        return false;
+
+    time = std::max(enter, 0.f);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef OVERLAP_HPP
+#define OVERLAP_HPP
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+/**
+ * Number of boxes tested by one call of overlapMask.
+ */
+constexpr std::size_t overlapWidth = 8;
+
+/**
+ * Test up to overlapWidth boxes against one rectangle (SSE/AVX when available).
+ * Boxes are given by separate arrays of their edges, overlap is the same as sf::Rect::intersects.
+ *
+ * \param count Number of boxes to test (at most overlapWidth).
+ * \param rect Tested rectangle.
+ * \return Bit mask, bit i is set when box i overlaps rectangle.
+ */
+unsigned int overlapMask(const float* minX, const float* minY, const float* maxX, const float* maxY,
+    std::size_t count, const sf::FloatRect& rect);
+/**
+ * Scalar version of overlapMask, used when no SIMD is available.
+ *
+ */
+unsigned int overlapMaskScalar(const float* minX, const float* minY, const float* maxX, const float* maxY,
+    std::size_t count, const sf::FloatRect& rect);
+
+/**
+ * Call function for each box which overlaps rectangle.
+ *
+ * \param count Number of boxes.
+ * \param rect Tested rectangle.
+ * \param function Function called with index of each overlapping box.
+ */
+template <typename Function>
+void forEachOverlap(const float* minX, const float* minY, const float* maxX, const float* maxY,
+    std::size_t count, const sf::FloatRect& rect, Function&& function)
+{
+    for (std::size_t first = 0; first < count; first += overlapWidth)
+    {
+        std::size_t width = count - first < overlapWidth ? count - first : overlapWidth;
+        unsigned int mask = overlapMask(minX + first, minY + first, maxX + first, maxY + first, width, rect);
+
+        // visit set bits from the lowest one
+        for (std::size_t i = 0; mask != 0; ++i, mask >>= 1)
+        {
+            if (mask & 1u)
+                function(first + i);
+        }
+    }
+}
+
+/**
+ * Find time of impact of moving box with a static target (swept box against box).
+ *
+ * \param box Box at the start of movement.
+ * \param move Movement of the box.
+ * \param target Target box.
+ * \param time Part of movement (0 to 1) after which box touches target, 0 when they already overlap.
+ * \return True if box hits target during movement.
+ */
+bool sweepBox(const sf::FloatRect& box, sf::Vector2f move, const sf::FloatRect& target, float& time);
+
+#endif // !OVERLAP_HPP
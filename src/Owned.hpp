@@ -0,0 +1,64 @@
+#ifndef OWNED_HPP
+#define OWNED_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+/**
+ * Represent a deleter of object created by create, returns memory of object
+ * to the memory resource it was taken from.
+ */
+struct Deleter
+{
+    std::pmr::memory_resource* memory;
+    /**
+     * Address, size and alignment of allocated memory (object can be deleted through a base class).
+     */
+    void* block;
+    std::size_t size;
+    std::size_t align;
+
+    template <typename T>
+    void operator () (T* object) const
+    {
+        object->~T();
+        memory->deallocate(block, size, align);
+    }
+};
+
+/**
+ * Pointer which owns an object created in a memory resource.
+ * Only storages (game state, entity for its sprite) own objects, everything else
+ * refers to them by raw pointers or ids.
+ */
+template <typename T>
+using Owned = std::unique_ptr<T, Deleter>;
+
+/**
+ * Create an object in a memory resource.
+ *
+ * \param memory Memory resource used for the object.
+ * \param args Arguments passed to constructor of T.
+ */
+template <typename T, typename... Args>
+Owned<T> create(std::pmr::memory_resource* memory, Args&&... args)
+{
+    void* block = memory->allocate(sizeof(T), alignof(T));
+    T* object;
+    try
+    {
+        object = new (block) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        memory->deallocate(block, sizeof(T), alignof(T));
+        throw;
+    }
+
+    return Owned<T>(object, Deleter{ memory, block, sizeof(T), alignof(T) });
+}
+
+#endif // !OWNED_HPP
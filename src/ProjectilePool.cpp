@@ -0,0 +1,78 @@
+#include "ProjectilePool.hpp"
+#include "Entities.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+    constexpr std::size_t blockAlign = alignof(std::max_align_t);
+}
+
+BlockPool::~BlockPool()
+{
+    if (storage_ != nullptr)
+        upstream_->deallocate(storage_, blockSize_ * capacity_, blockAlign);
+}
+
+void* BlockPool::do_allocate(std::size_t bytes, std::size_t align)
+{
+    // first allocation determines size of blocks
+    if (storage_ == nullptr)
+    {
+        blockSize_ = (std::max(bytes, sizeof(void*)) + blockAlign - 1) / blockAlign * blockAlign;
+        storage_ = static_cast<unsigned char*>(upstream_->allocate(blockSize_ * capacity_, blockAlign));
+
+        // chain all blocks to free list
+        for (std::size_t i = capacity_; i > 0; --i)
+        {
+            void* block = storage_ + (i - 1) * blockSize_;
+            *static_cast<void**>(block) = free_;
+            free_ = block;
+        }
+    }
+
+    if (free_ == nullptr || bytes > blockSize_ || align > blockAlign)
+    {
+        misses_++;
+        return upstream_->allocate(bytes, align);
+    }
+
+    void* block = free_;
+    free_ = *static_cast<void**>(block);
+
+    hits_++;
+    used_++;
+    highWater_ = std::max(highWater_, used_);
+
+    return block;
+}
+
+void BlockPool::do_deallocate(void* block, std::size_t bytes, std::size_t align)
+{
+    if (!owns(block))
+    {
+        upstream_->deallocate(block, bytes, align);
+        return;
+    }
+
+    *static_cast<void**>(block) = free_;
+    free_ = block;
+    used_--;
+}
+
+bool BlockPool::owns(void* block) const
+{
+    auto begin = reinterpret_cast<std::uintptr_t>(storage_);
+    auto address = reinterpret_cast<std::uintptr_t>(block);
+
+    return storage_ != nullptr && address >= begin && address < begin + blockSize_ * capacity_;
+}
+
+Owned<Projectile> ProjectilePool::acquire(GameState* state, sf::Vector2f pos, float speed,
+    EntityType target)
+{
+    RectSprite sprite(pos, sf::Vector2f(3.f, 5.f), sf::Color::Green);
+
+    return create<Projectile>(&projectiles_, state, sprite, speed, target);
+}
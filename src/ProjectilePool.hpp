@@ -0,0 +1,120 @@
+#ifndef PROJECTILE_POOL_HPP
+#define PROJECTILE_POOL_HPP
+
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <memory_resource>
+
+#include "Owned.hpp"
+
+class GameState;
+class Projectile;
+enum class EntityType : unsigned int;
+
+/**
+ * Represent a fixed number of equally sized memory blocks with a free list.
+ * Size of blocks is determined by the first allocation, requests which do not
+ * fit or which come when all blocks are used fall back to the upstream resource.
+ */
+class BlockPool final : public std::pmr::memory_resource
+{
+public:
+    /**
+     * \param capacity Number of blocks.
+     * \param upstream Resource used for memory of blocks and for requests which do not fit.
+     */
+    BlockPool(std::size_t capacity, std::pmr::memory_resource* upstream)
+        : capacity_(capacity), upstream_(upstream) {}
+    ~BlockPool();
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator = (const BlockPool&) = delete;
+
+    /**
+     * Get number of allocations served by the pool.
+     *
+     */
+    std::size_t getHits() const { return hits_; }
+    /**
+     * Get number of allocations which had to fall back to the upstream resource.
+     *
+     */
+    std::size_t getMisses() const { return misses_; }
+    /**
+     * Get maximal number of blocks used at once.
+     *
+     */
+    std::size_t getHighWater() const { return highWater_; }
+    /**
+     * Get number of currently used blocks.
+     *
+     */
+    std::size_t getUsed() const { return used_; }
+private:
+    std::size_t capacity_;
+    std::size_t blockSize_{ 0 };
+    std::pmr::memory_resource* upstream_;
+    /**
+     * Memory of all blocks, allocated by the first allocation.
+     */
+    unsigned char* storage_{ nullptr };
+    /**
+     * Free blocks, each free block contains pointer to the next one.
+     */
+    void* free_{ nullptr };
+
+    std::size_t hits_{ 0 };
+    std::size_t misses_{ 0 };
+    std::size_t highWater_{ 0 };
+    std::size_t used_{ 0 };
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override;
+    void do_deallocate(void* block, std::size_t bytes, std::size_t align) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    bool owns(void* block) const;
+};
+
+/**
+ * Represent a pool of projectiles (their rect sprites are stored inside them).
+ * Projectiles are placed into pool's blocks and return there when projectile
+ * is destroyed, so shooting does not allocate any memory while pool has free blocks.
+ */
+class ProjectilePool
+{
+public:
+    /**
+     * \param capacity Maximal number of pooled projectiles alive at once.
+     * \param upstream Resource used for memory of the pool.
+     */
+    ProjectilePool(std::size_t capacity, std::pmr::memory_resource* upstream)
+        : projectiles_(capacity, upstream) {}
+
+    /**
+     * Create a projectile.
+     *
+     * \param state Owner of projectile.
+     * \param pos Position of projectile.
+     * \param speed Vertical speed of projectile.
+     * \param target Types of entites who are target of projectile.
+     */
+    Owned<Projectile> acquire(GameState* state, sf::Vector2f pos, float speed, EntityType target);
+
+    /**
+     * Get number of projectiles created from the pool.
+     *
+     */
+    std::size_t getHits() const { return projectiles_.getHits(); }
+    /**
+     * Get number of projectiles which did not fit into the pool.
+     *
+     */
+    std::size_t getMisses() const { return projectiles_.getMisses(); }
+    /**
+     * Get maximal number of pooled projectiles alive at once.
+     *
+     */
+    std::size_t getHighWater() const { return projectiles_.getHighWater(); }
+private:
+    BlockPool projectiles_;
+};
+
+#endif // !PROJECTILE_POOL_HPP
@@ -0,0 +1,62 @@
+#include "Random.hpp"
+
+Random::Random(std::uint64_t seed)
+{
+    // splitmix64, never produces all-zero state
+    for (auto&& word : state_)
+    {
+        std::uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        word = z ^ (z >> 31);
+    }
+}
+
+void Random::fill(float* values, std::size_t count)
+{
+    // two numbers from each 64 bits
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        std::uint64_t bits = next();
+        values[i] = (float)(bits >> 40) / 16777216.f;
+        values[i + 1] = (float)((bits >> 8) & 0xffffff) / 16777216.f;
+    }
+    if (i < count)
+        values[i] = nextFloat();
+}
+
+void Random::jump()
+{
+    static constexpr std::uint64_t polynomial[] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+
+    std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+    for (std::uint64_t word : polynomial)
+    {
+        for (int bit = 0; bit < 64; ++bit)
+        {
+            if (word & (std::uint64_t(1) << bit))
+            {
+                for (int i = 0; i < 4; ++i)
+                    jumped[i] ^= state_[i];
+            }
+            next();
+        }
+    }
+
+    for (int i = 0; i < 4; ++i)
+        state_[i] = jumped[i];
+}
+
+RandomService::RandomService(std::uint64_t seed) : seed_(seed)
+{
+    // each stream starts 2^128 numbers after the previous one
+    Random random(seed);
+    for (auto&& stream : streams_)
+    {
+        stream = random;
+        random.jump();
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Represent a pseudo-random generator (xoshiro256**).
+ * Generator is small and fast and has no global state, so each subsystem can own its own
+ * stream and the same seed always produces the same numbers.
+ */
+class Random
+{
+public:
+    /**
+     * Create generator, its 256 bit state is expanded from the seed by splitmix64.
+     * 
+     */
+    explicit Random(std::uint64_t seed = 0);
+
+    /**
+     * Get next 64 random bits.
+     * 
+     */
+    std::uint64_t next()
+    {
+        std::uint64_t result = rotate(state_[1] * 5, 7) * 9;
+        std::uint64_t shifted = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= shifted;
+        state_[3] = rotate(state_[3], 45);
+
+        return result;
+    }
+    /**
+     * Get uniformly distributed number from [0, 1).
+     * 
+     */
+    float nextFloat() { return (float)(next() >> 40) / 16777216.f; }
+    /**
+     * Get uniformly distributed integer from [0, bound).
+     * 
+     */
+    unsigned int nextBelow(unsigned int bound) { return (unsigned int)(((next() >> 32) * bound) >> 32); }
+    /**
+     * Fill array with uniformly distributed numbers from [0, 1).
+     * 
+     * \param count Number of elements of array.
+     */
+    void fill(float* values, std::size_t count);
+    /**
+     * Advance generator by 2^128 numbers, used to split one seed to non-overlapping streams.
+     * 
+     */
+    void jump();
+private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t rotate(std::uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+};
+
+/**
+ * Represent a subsystem which owns its own random stream.
+ */
+enum class RandomStream : unsigned int
+{
+    EnemyFire,
+    Ufo,
+    Effects,
+    Count,
+};
+
+/**
+ * Represent independent random streams of one game state, all derived from one seed.
+ * Numbers drawn from one stream do not change other streams, so adding a consumer
+ * to one subsystem does not change behaviour of others. Streams are not thread-safe,
+ * each stream has to be used by one thread at a time.
+ */
+class RandomService
+{
+public:
+    /**
+     * \param seed Seed of all streams.
+     */
+    explicit RandomService(std::uint64_t seed);
+
+    /**
+     * Get generator of a stream.
+     * 
+     */
+    Random& get(RandomStream stream) { return streams_[static_cast<unsigned int>(stream)]; }
+    std::uint64_t getSeed() const { return seed_; }
+private:
+    std::uint64_t seed_;
+    Random streams_[static_cast<unsigned int>(RandomStream::Count)];
+};
+
+#endif // !RANDOM_HPP
@@ -0,0 +1,148 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AnimationManager.hpp"
+#include "Bitmap.hpp"
+
+/**
+ * Represent one drawn sprite of render snapshot.
+ */
+struct RenderItem
+{
+    enum class Kind : unsigned int
+    {
+        Rect,
+        Image,
+        Text,
+        Bitmap,
+    };
+
+    Kind kind;
+    /**
+     * Position before the last update and current position, renderer interpolates between them.
+     * Center of rectangle and image, top-left corner of text and bitmap.
+     */
+    sf::Vector2f prev;
+    sf::Vector2f pos;
+    sf::Vector2f size;
+    sf::Color color;
+    /**
+     * Animation clip and its frame (Image).
+     */
+    ClipId clip;
+    unsigned int frame;
+    /**
+     * Font, size of characters and index of string in snapshot (Text).
+     */
+    const sf::Font* font;
+    unsigned int charSize;
+    unsigned int text;
+    /**
+     * Index of bitmap in snapshot and key of its texture in renderer, e.g. entity id (Bitmap).
+     */
+    unsigned int bitmap;
+    std::uint64_t key;
+};
+
+/**
+ * Represent everything which is drawn in one frame, captured by simulation after an update.
+ * Snapshot contains only values (positions, frame ids, strings and shared immutable bitmaps),
+ * so render thread can draw it while simulation already updates entities.
+ * Items are drawn in the order in which they were added.
+ */
+class RenderSnapshot
+{
+public:
+    /**
+     * Remove all items, memory of snapshot is kept for the next capture.
+     * 
+     */
+    void clear()
+    {
+        items_.clear();
+        bitmaps_.clear();
+        textCount_ = 0;
+    }
+
+    void addRect(sf::Vector2f prev, sf::Vector2f pos, sf::Vector2f size, sf::Color color)
+    {
+        RenderItem item{};
+        item.kind = RenderItem::Kind::Rect;
+        item.prev = prev;
+        item.pos = pos;
+        item.size = size;
+        item.color = color;
+        items_.push_back(item);
+    }
+    void addImage(sf::Vector2f prev, sf::Vector2f pos, sf::Vector2f size, ClipId clip, unsigned int frame)
+    {
+        RenderItem item{};
+        item.kind = RenderItem::Kind::Image;
+        item.prev = prev;
+        item.pos = pos;
+        item.size = size;
+        item.clip = clip;
+        item.frame = frame;
+        items_.push_back(item);
+    }
+    void addText(sf::Vector2f pos, const sf::Font* font, const std::string& string, unsigned int charSize,
+        sf::Color color)
+    {
+        // strings are reused between captures, so steady text does not allocate
+        if (textCount_ == texts_.size())
+            texts_.emplace_back();
+        texts_[textCount_].assign(string);
+
+        RenderItem item{};
+        item.kind = RenderItem::Kind::Text;
+        item.prev = pos;
+        item.pos = pos;
+        item.color = color;
+        item.font = font;
+        item.charSize = charSize;
+        item.text = textCount_++;
+        items_.push_back(item);
+    }
+    /**
+     * Add bitmap drawn by one color.
+     * 
+     * \param key Key of bitmap's texture in renderer, texture is updated only when bitmap changes.
+     * \param bitmap Bitmap which is not changed anymore (changed bitmap has to be a new object).
+     */
+    void addBitmap(std::uint64_t key, sf::Vector2f pos, std::shared_ptr<const Bitmap> bitmap, sf::Color color)
+    {
+        RenderItem item{};
+        item.kind = RenderItem::Kind::Bitmap;
+        item.prev = pos;
+        item.pos = pos;
+        item.color = color;
+        item.bitmap = (unsigned int)bitmaps_.size();
+        item.key = key;
+        items_.push_back(item);
+        bitmaps_.push_back(std::move(bitmap));
+    }
+
+    const std::vector<RenderItem>& getItems() const { return items_; }
+    const std::string& getText(const RenderItem& item) const { return texts_[item.text]; }
+    const std::shared_ptr<const Bitmap>& getBitmap(const RenderItem& item) const { return bitmaps_[item.bitmap]; }
+    /**
+     * Get time of capture (see Game's clock).
+     * 
+     */
+    sf::Time getTime() const { return time_; }
+    void setTime(sf::Time time) { time_ = time; }
+private:
+    std::vector<RenderItem> items_;
+    std::vector<std::string> texts_;
+    std::size_t textCount_{ 0 };
+    std::vector<std::shared_ptr<const Bitmap>> bitmaps_;
+    sf::Time time_;
+};
+
+#endif // !RENDER_SNAPSHOT_HPP
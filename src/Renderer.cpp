@@ -0,0 +1,104 @@
+#include "Renderer.hpp"
+#include "TextureManager.hpp"
+
+#include <algorithm>
+#include <vector>
+
+void Renderer::draw(const RenderSnapshot& snapshot, float alpha, sf::RenderWindow& window)
+{
+    for (const RenderItem& item : snapshot.getItems())
+    {
+        sf::Vector2f pos = item.prev + (item.pos - item.prev) * alpha;
+        switch (item.kind)
+        {
+            case RenderItem::Kind::Rect:
+            {
+                sf::RectangleShape shape;
+                shape.setSize(item.size);
+                shape.setOrigin(item.size / 2.f);
+                shape.setPosition(pos);
+                shape.setFillColor(item.color);
+
+                window.draw(shape);
+                break;
+            }
+            case RenderItem::Kind::Image:
+            {
+                const AnimationClip& clip = AnimationManager::getInstance().get(item.clip);
+                const sf::IntRect& frame = clip.frames[item.frame];
+
+                sf::Sprite sprite;
+                sprite.setTexture(TextureManager::getInstance().get(clip.texture));
+                sprite.setTextureRect(frame);
+                sprite.setOrigin(sf::Vector2f((float)frame.width, (float)frame.height) / 2.f);
+                sprite.setPosition(pos);
+                sprite.setScale(item.size.x / frame.width, item.size.y / frame.height);
+
+                window.draw(sprite);
+                break;
+            }
+            case RenderItem::Kind::Text:
+            {
+                sf::Text text;
+                text.setPosition(pos);
+                text.setFont(*item.font);
+                text.setString(snapshot.getText(item));
+                text.setCharacterSize(item.charSize);
+                text.setFillColor(item.color);
+
+                window.draw(text);
+                break;
+            }
+            case RenderItem::Kind::Bitmap:
+            {
+                sf::Sprite sprite(getTexture(snapshot, item));
+                sprite.setPosition(pos);
+                sprite.setColor(item.color);
+
+                window.draw(sprite);
+                break;
+            }
+        }
+    }
+
+    // free textures of bitmaps which were not drawn
+    for (auto it = bitmaps_.begin(); it != bitmaps_.end();)
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+            it = bitmaps_.erase(it);
+    }
+}
+
+const sf::Texture& Renderer::getTexture(const RenderSnapshot& snapshot, const RenderItem& item)
+{
+    const std::shared_ptr<const Bitmap>& bitmap = snapshot.getBitmap(item);
+    BitmapTexture& cached = bitmaps_[item.key];
+    cached.used = true;
+    if (cached.bitmap == bitmap)
+        return cached.texture;
+
+    // bitmap is drawn white and tinted by color of item
+    unsigned int width = bitmap->getWidth();
+    unsigned int height = bitmap->getHeight();
+    std::vector<sf::Uint8> pixels(width * height * 4, 0);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            if (bitmap->get(x, y))
+                std::fill_n(&pixels[(y * width + x) * 4], 4, (sf::Uint8)255);
+        }
+    }
+
+    if (cached.texture.getSize() != sf::Vector2u(width, height))
+        cached.texture.create(width, height);
+    cached.texture.update(pixels.data());
+    cached.bitmap = bitmap;
+
+    return cached.texture;
+}
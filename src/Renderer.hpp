@@ -0,0 +1,53 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "RenderSnapshot.hpp"
+
+/**
+ * Represent a renderer which draws render snapshots to window (on render thread).
+ * Renderer reads only snapshot and managers of textures, clips and fonts, which are not changed
+ * after game state is initialized, so it never touches entities.
+ */
+class Renderer
+{
+public:
+    /**
+     * Draw snapshot to window.
+     * 
+     * \param snapshot Snapshot captured after the last update.
+     * \param alpha Part of update (0 to 1) elapsed since the snapshot was captured.
+     * \param window Window to which is snapshot drawn.
+     */
+    void draw(const RenderSnapshot& snapshot, float alpha, sf::RenderWindow& window);
+private:
+    /**
+     * Texture of bitmap and bitmap from which was texture created.
+     */
+    struct BitmapTexture
+    {
+        std::shared_ptr<const Bitmap> bitmap;
+        sf::Texture texture;
+        /**
+         * Determine if bitmap was drawn by the current frame (texture of removed bitmap is freed).
+         */
+        bool used;
+    };
+
+    /**
+     * Textures of bitmaps by their keys.
+     */
+    std::unordered_map<std::uint64_t, BitmapTexture> bitmaps_;
+
+    /**
+     * Get texture of bitmap, texture is updated only when bitmap is a different object.
+     * 
+     */
+    const sf::Texture& getTexture(const RenderSnapshot& snapshot, const RenderItem& item);
+};
+
+#endif // !RENDERER_HPP
@@ -0,0 +1,190 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Represent a dense container addressed by generational handles.
+ * Values are stored contiguously, so iteration does not chase any pointers,
+ * lookup by handle is O(1) and removal moves the last value into the hole.
+ * Each removal bumps generation of the slot, so handles of removed values
+ * are rejected instead of pointing to a new value.
+ * Handle uses IndexBits bits for slot index and GenerationBits bits (at most 32) for generation,
+ * remaining high bits of handle are always zero. Generation wraps around after 2^GenerationBits
+ * removals from one slot, so stale handle can match a new value only after so many reuses.
+ */
+template <typename T, unsigned int IndexBits = 32, unsigned int GenerationBits = 64 - IndexBits>
+class SlotMap
+{
+public:
+    using Handle = std::uint64_t;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    /**
+     * Handle which never belongs to any value.
+     */
+    static constexpr Handle invalid = ~Handle(0);
+
+    /**
+     * Insert value to a slot map.
+     *
+     * \param value Value to insert.
+     * \return Handle of inserted value.
+     */
+    Handle insert(T value)
+    {
+        unsigned int index;
+        if (freeHead_ != npos_)
+        {
+            index = freeHead_;
+            freeHead_ = slots_[index].dense;
+        }
+        else
+        {
+            index = (unsigned int)slots_.size();
+            slots_.push_back(Slot{ npos_, 0 });
+        }
+
+        slots_[index].dense = (unsigned int)values_.size();
+        values_.push_back(std::move(value));
+        denseToSlot_.push_back(index);
+
+        return makeHandle(index, slots_[index].generation);
+    }
+    /**
+     * Remove value from a slot map.
+     *
+     * \param handle Handle of value to remove.
+     * \return True if value was removed, false if handle is stale.
+     */
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        unsigned int index = (unsigned int)(handle & indexMask_);
+        unsigned int dense = slots_[index].dense;
+        unsigned int last = (unsigned int)values_.size() - 1;
+
+        // move last value into the hole
+        if (dense != last)
+        {
+            values_[dense] = std::move(values_[last]);
+            denseToSlot_[dense] = denseToSlot_[last];
+            slots_[denseToSlot_[dense]].dense = dense;
+        }
+        values_.pop_back();
+        denseToSlot_.pop_back();
+
+        // invalidate all handles to the slot and put it on free list
+        slots_[index].generation = (slots_[index].generation + 1) & generationMask_;
+        slots_[index].dense = freeHead_;
+        freeHead_ = index;
+
+        return true;
+    }
+    /**
+     * Get value with specific handle.
+     *
+     * \return Pointer to the value or nullptr if handle is stale.
+     */
+    T* find(Handle handle)
+    {
+        return contains(handle) ? &values_[slots_[handle & indexMask_].dense] : nullptr;
+    }
+    /**
+     * Get value with specific handle.
+     *
+     * \return Pointer to the value or nullptr if handle is stale.
+     */
+    const T* find(Handle handle) const
+    {
+        return contains(handle) ? &values_[slots_[handle & indexMask_].dense] : nullptr;
+    }
+    /**
+     * Determine if handle belongs to a value in slot map.
+     *
+     */
+    bool contains(Handle handle) const
+    {
+        unsigned int index = (unsigned int)(handle & indexMask_);
+        return index < slots_.size() && slots_[index].generation == (handle >> indexBits_)
+            && slots_[index].dense < values_.size() && denseToSlot_[slots_[index].dense] == index;
+    }
+    /**
+     * Get handle of value stored at specific position of dense storage.
+     *
+     */
+    Handle handleAt(std::size_t dense) const
+    {
+        unsigned int index = denseToSlot_[dense];
+        return makeHandle(index, slots_[index].generation);
+    }
+    /**
+     * Remove all values, all handles become stale.
+     *
+     */
+    void clear()
+    {
+        for (std::size_t i = values_.size(); i > 0; --i)
+            erase(handleAt(i - 1));
+    }
+
+    std::size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    iterator begin() { return values_.begin(); }
+    iterator end() { return values_.end(); }
+    const_iterator begin() const { return values_.begin(); }
+    const_iterator end() const { return values_.end(); }
+private:
+    static_assert(IndexBits <= 32 && GenerationBits <= 32, "Slot stores index and generation in 32 bits.");
+    static_assert(IndexBits + GenerationBits <= 64, "Handle has only 64 bits.");
+
+    static constexpr unsigned int indexBits_ = IndexBits;
+    static constexpr Handle indexMask_ = (Handle(1) << indexBits_) - 1;
+    static constexpr unsigned int generationMask_ = ~0u >> (32 - GenerationBits);
+    /**
+     * Marks end of free list.
+     */
+    static constexpr unsigned int npos_ = ~0u;
+
+    struct Slot
+    {
+        /**
+         * Index to dense storage for used slot, next free slot for unused slot.
+         */
+        unsigned int dense;
+        /**
+         * Incremented every time slot is freed.
+         */
+        unsigned int generation;
+    };
+
+    /**
+     * Contains values (dense storage).
+     */
+    std::vector<T> values_;
+    /**
+     * Maps position in dense storage to slot index.
+     */
+    std::vector<unsigned int> denseToSlot_;
+    /**
+     * Maps handle's index to position in dense storage.
+     */
+    std::vector<Slot> slots_;
+    /**
+     * First free slot.
+     */
+    unsigned int freeHead_{ npos_ };
+
+    static Handle makeHandle(unsigned int index, unsigned int generation)
+    {
+        return (Handle(generation) << indexBits_) | index;
+    }
+};
+
+#endif // !SLOT_MAP_HPP
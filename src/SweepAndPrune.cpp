@@ -0,0 +1,122 @@
+#include "SweepAndPrune.hpp"
+#include "GameState.hpp"
+#include "Overlap.hpp"
+
+#include <algorithm>
+
+void SweepAndPrune::clear()
+{
+    boxes_.clear();
+    active_.clear();
+    pairs_.clear();
+}
+
+void SweepAndPrune::clearStatic()
+{
+    static_.clear();
+    activeStatic_.clear();
+    staticSorted_ = true;
+}
+
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::sweep()
+{
+    active_.clear();
+    activeStatic_.clear();
+    pairs_.clear();
+
+    auto lower = [](const Box& left, const Box& right) { return left.rect.left < right.rect.left; };
+    std::sort(boxes_.begin(), boxes_.end(), lower);
+    if (!staticSorted_)
+    {
+        std::sort(static_.begin(), static_.end(), lower);
+        staticSorted_ = true;
+    }
+
+    // merge both sorted lists
+    unsigned int dynamicCount = (unsigned int)boxes_.size();
+    for (std::size_t i = 0, j = 0; i < boxes_.size() || j < static_.size();)
+    {
+        bool dynamic = j == static_.size() || (i < boxes_.size() && boxes_[i].rect.left <= static_[j].rect.left);
+        unsigned int index = dynamic ? (unsigned int)i++ : dynamicCount + (unsigned int)j++;
+        const Box& box = getBox(index);
+
+        // boxes which end before this box starts cannot overlap any following box
+        active_.removeEnded(box.rect.left);
+        activeStatic_.removeEnded(box.rect.left);
+
+        test(index, active_);
+        if (dynamic)
+            test(index, activeStatic_);
+
+        (dynamic ? active_ : activeStatic_).push(index, box.rect);
+    }
+
+    std::sort(pairs_.begin(), pairs_.end(), [](const Pair& left, const Pair& right)
+    {
+        return left.source < right.source;
+    });
+
+    return pairs_;
+}
+
+void SweepAndPrune::test(unsigned int index, const ActiveList& active)
+{
+    const Box& box = getBox(index);
+    forEachOverlap(active.minX.data(), active.minY.data(), active.maxX.data(), active.maxY.data(),
+        active.indices.size(), box.rect, [this, index, &active](std::size_t i)
+    {
+        addPairs(index, active.indices[i]);
+    });
+}
+
+void SweepAndPrune::addPairs(unsigned int first, unsigned int second)
+{
+    const Box& box = getBox(first);
+    const Box& candidate = getBox(second);
+    if ((box.targets & candidate.type) != EntityType::None)
+        pairs_.push_back(Pair{ first, second });
+    if ((candidate.targets & box.type) != EntityType::None)
+        pairs_.push_back(Pair{ second, first });
+}
+
+void SweepAndPrune::ActiveList::clear()
+{
+    indices.clear();
+    minX.clear();
+    minY.clear();
+    maxX.clear();
+    maxY.clear();
+}
+
+void SweepAndPrune::ActiveList::push(unsigned int index, const sf::FloatRect& rect)
+{
+    indices.push_back(index);
+    minX.push_back(rect.left);
+    minY.push_back(rect.top);
+    maxX.push_back(rect.left + rect.width);
+    maxY.push_back(rect.top + rect.height);
+}
+
+void SweepAndPrune::ActiveList::removeEnded(float x)
+{
+    // compact all arrays at once, order of remaining boxes is kept
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        if (maxX[i] < x)
+            continue;
+
+        indices[kept] = indices[i];
+        minX[kept] = minX[i];
+        minY[kept] = minY[i];
+        maxX[kept] = maxX[i];
+        maxY[kept] = maxY[i];
+        kept++;
+    }
+
+    indices.resize(kept);
+    minX.resize(kept);
+    minY.resize(kept);
+    maxX.resize(kept);
+    maxY.resize(kept);
+}
@@ -0,0 +1,139 @@
+#ifndef SWEEP_AND_PRUNE_HPP
+#define SWEEP_AND_PRUNE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+enum class EntityType : unsigned int;
+
+/**
+ * Represent a collision stage which finds all colliding pairs at once.
+ * Boxes are sorted by their left edge and swept from left to right, each box is tested
+ * only against boxes whose x range is still open, so whole pass is O(n log n + pairs).
+ * Edges of open boxes are kept in separate arrays and tested against new box by overlapMask.
+ * Boxes of sleeping entities are kept in a separate static list, which is sorted only when
+ * it changes. Static boxes are tested only against dynamic ones (two sleeping entities do not collide).
+ */
+class SweepAndPrune
+{
+public:
+    /**
+     * Represent a rigid body of entity.
+     */
+    struct Box
+    {
+        std::uint64_t id;
+        /**
+         * Type of entity.
+         */
+        EntityType type;
+        /**
+         * Types of entities which entity collides with (see Entity::getTargets).
+         */
+        EntityType targets;
+        sf::FloatRect rect;
+    };
+    /**
+     * Represent a collision, source is the entity whose targets contain type of target entity.
+     * Both are indices to boxes.
+     */
+    struct Pair
+    {
+        unsigned int source;
+        unsigned int target;
+    };
+
+    /**
+     * Remove all dynamic boxes and pairs.
+     * 
+     */
+    void clear();
+    /**
+     * Remove all static boxes.
+     * 
+     */
+    void clearStatic();
+    /**
+     * Insert dynamic box to the next sweep.
+     * 
+     */
+    void insert(const Box& box) { boxes_.push_back(box); }
+    /**
+     * Insert static box, static boxes stay until clearStatic.
+     * 
+     */
+    void insertStatic(const Box& box)
+    {
+        static_.push_back(box);
+        staticSorted_ = false;
+    }
+    /**
+     * Find all pairs of overlapping boxes where one box targets the other.
+     * Pairs are sorted by source.
+     * 
+     */
+    const std::vector<Pair>& sweep();
+    /**
+     * Get box by its index (boxes are reordered by sweep), static boxes follow dynamic ones.
+     * 
+     */
+    const Box& getBox(unsigned int index) const
+    {
+        return index < boxes_.size() ? boxes_[index] : static_[index - boxes_.size()];
+    }
+private:
+    /**
+     * Dynamic boxes.
+     */
+    std::vector<Box> boxes_;
+    /**
+     * Static boxes.
+     */
+    std::vector<Box> static_;
+    bool staticSorted_{ true };
+
+    /**
+     * Represent boxes whose x range overlaps current sweep position (structure of arrays).
+     */
+    struct ActiveList
+    {
+        /**
+         * Indices of boxes.
+         */
+        std::vector<unsigned int> indices;
+        std::vector<float> minX;
+        std::vector<float> minY;
+        std::vector<float> maxX;
+        std::vector<float> maxY;
+
+        void clear();
+        void push(unsigned int index, const sf::FloatRect& rect);
+        /**
+         * Remove boxes which end before x.
+         * 
+         */
+        void removeEnded(float x);
+    };
+
+    /**
+     * Dynamic and static boxes whose x range overlaps current sweep position.
+     */
+    ActiveList active_;
+    ActiveList activeStatic_;
+    std::vector<Pair> pairs_;
+
+    /**
+     * Test box against all boxes of active list (see overlapMask).
+     * 
+     * \param index Index of tested box.
+     */
+    void test(unsigned int index, const ActiveList& active);
+    /**
+     * Add pairs of two overlapping boxes (in both directions if both target each other).
+     * 
+     */
+    void addPairs(unsigned int first, unsigned int second);
+};
+
+#endif // !SWEEP_AND_PRUNE_HPP
@@ -1,12 +1,20 @@
 #ifndef TEXTURE_MANAGER_HPP
 #define TEXTURE_MANAGER_HPP
 
+#include <deque>
 #include <map>
 #include <string>
 #include <SFML/Graphics.hpp>
 
+/**
+ * Represent a handle of texture loaded in texture manager.
+ */
+using TextureId = unsigned int;
+
 /**
  * Represent a manager of textures.
+ * Each texture is also kept as an image in memory (e.g. for collision masks), headless
+ * manager keeps only images, so it does not need any graphics context.
  * (Singleton)
  */
 class TextureManager
@@ -24,34 +32,88 @@ public:
 	}
 
 	/**
-	 * Load new texture to manager.
+	 * Load new texture to manager, texture which is already loaded is not loaded again.
 	 * 
 	 * \param path Path to a texture.
 	 * \param name Name of a texture.
+	 * \return Handle of the texture.
 	 */
-	void load(const std::string& path, const std::string& name)
+	TextureId load(const std::string& path, const std::string& name)
 	{
-		auto it = textures_.insert({ name, sf::Texture() }).first;
-		(*it).second.loadFromFile(path);
+		auto it = ids_.find(name);
+		if (it != ids_.end())
+			return (*it).second;
+
+		TextureId id = (TextureId)textures_.size();
+		images_.emplace_back();
+		images_.back().loadFromFile(path);
+		textures_.emplace_back();
+		if (!headless_)
+			textures_.back().loadFromImage(images_.back());
+		ids_.insert({ name, id });
+
+		return id;
+	}
+
+	/**
+	 * Get handle of loaded texture.
+	 * Resolve handles once at load time, lookup by name compares strings.
+	 * 
+	 * \param name Name of texture.
+	 */
+	TextureId getId(const std::string& name) const
+	{
+		return ids_.at(name);
 	}
 
 	/**
 	 * Get loaded texture from manager.
 	 * 
-	 * \param name Name of texture to get.
-	 * \return Texture with specific name.
+	 * \param id Handle of texture to get.
+	 * \return Texture with specific handle.
 	 */
-	sf::Texture& get(const std::string& name)
+	sf::Texture& get(TextureId id)
 	{
-		return textures_[name];
+		return textures_[id];
+	}
+
+	/**
+	 * Get image of loaded texture (available also in headless manager).
+	 * 
+	 * \param id Handle of texture.
+	 */
+	const sf::Image& getImage(TextureId id) const
+	{
+		return images_[id];
+	}
+
+	/**
+	 * Set if textures are loaded only as images (has to be set before loading).
+	 * 
+	 */
+	void setHeadless(bool headless)
+	{
+		headless_ = headless;
 	}
 private:
 	TextureManager() {}
 
 	/**
-	 * Contains all loaded textures.
+	 * Contains all loaded textures, indexed by their handles.
+	 */
+	std::deque<sf::Texture> textures_;
+	/**
+	 * Contains images of all loaded textures, indexed by their handles.
+	 */
+	std::deque<sf::Image> images_;
+	/**
+	 * Determine if textures are not uploaded to graphics card.
+	 */
+	bool headless_{ false };
+	/**
+	 * Maps names of textures to their handles.
 	 */
-	std::map<std::string, sf::Texture> textures_;
+	std::map<std::string, TextureId> ids_;
 };
 
 #endif // !TEXTURE_MANAGER_HPP
\ No newline at end of file
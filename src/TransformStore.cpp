@@ -0,0 +1,188 @@
+#include "TransformStore.hpp"
+#include "Entity.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRANSFORM_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define TRANSFORM_SSE
+#endif
+
+unsigned int TransformStore::add(Entity* owner, sf::Vector2f pos, sf::Vector2f speed, sf::Vector2f size)
+{
+    x_.push_back(pos.x);
+    y_.push_back(pos.y);
+    prevX_.push_back(pos.x);
+    prevY_.push_back(pos.y);
+    speedX_.push_back(speed.x);
+    speedY_.push_back(speed.y);
+    width_.push_back(size.x);
+    height_.push_back(size.y);
+    owners_.push_back(owner);
+
+    float minX, minY, maxX, maxY;
+    computeBounds(pos.x, pos.y, 0.f, 0.f, size.x, size.y, minX, minY, maxX, maxY);
+    minX_.push_back(minX);
+    minY_.push_back(minY);
+    maxX_.push_back(maxX);
+    maxY_.push_back(maxY);
+
+    // new transform is awake until its bounds are computed, set of sleeping transforms is not changed
+    unsigned int index = (unsigned int)owners_.size() - 1;
+    swap(index, (unsigned int)awake_);
+    return (unsigned int)awake_++;
+}
+
+void TransformStore::remove(unsigned int index)
+{
+    // move transform to the end of its partition, then to the end of arrays
+    if (index < awake_)
+    {
+        swap(index, (unsigned int)awake_ - 1);
+        index = (unsigned int)--awake_;
+    }
+    else
+        sleepVersion_++;
+    swap(index, (unsigned int)owners_.size() - 1);
+
+    x_.pop_back();
+    y_.pop_back();
+    prevX_.pop_back();
+    prevY_.pop_back();
+    speedX_.pop_back();
+    speedY_.pop_back();
+    width_.pop_back();
+    height_.pop_back();
+    minX_.pop_back();
+    minY_.pop_back();
+    maxX_.pop_back();
+    maxY_.pop_back();
+    owners_.pop_back();
+}
+
+void TransformStore::translate(Entity* const* owners, std::size_t count, sf::Vector2f offset)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        unsigned int index = wake(owners[i]->transform_);
+        x_[index] = prevX_[index] = x_[index] + offset.x;
+        y_[index] = prevY_[index] = y_[index] + offset.y;
+    }
+}
+
+unsigned int TransformStore::wake(unsigned int index)
+{
+    if (index < awake_)
+        return index;
+
+    swap(index, (unsigned int)awake_);
+    sleepVersion_++;
+    return (unsigned int)awake_++;
+}
+
+void TransformStore::swap(unsigned int first, unsigned int second)
+{
+    if (first == second)
+        return;
+
+    std::swap(x_[first], x_[second]);
+    std::swap(y_[first], y_[second]);
+    std::swap(prevX_[first], prevX_[second]);
+    std::swap(prevY_[first], prevY_[second]);
+    std::swap(speedX_[first], speedX_[second]);
+    std::swap(speedY_[first], speedY_[second]);
+    std::swap(width_[first], width_[second]);
+    std::swap(height_[first], height_[second]);
+    std::swap(minX_[first], minX_[second]);
+    std::swap(minY_[first], minY_[second]);
+    std::swap(maxX_[first], maxX_[second]);
+    std::swap(maxY_[first], maxY_[second]);
+    std::swap(owners_[first], owners_[second]);
+    owners_[first]->transform_ = first;
+    owners_[second]->transform_ = second;
+}
+
+void TransformStore::integrate(float ms)
+{
+    ::integrate(x_.data(), y_.data(), prevX_.data(), prevY_.data(), speedX_.data(), speedY_.data(), awake_, ms);
+}
+
+void TransformStore::updateBounds(float ms)
+{
+    for (std::size_t i = 0; i < awake_; ++i)
+    {
+        computeBounds(x_[i], y_[i], speedX_[i] * ms, speedY_[i] * ms, width_[i], height_[i],
+            minX_[i], minY_[i], maxX_[i], maxY_[i]);
+    }
+
+    // transforms without speed fall asleep, their bounds stay valid until they are woken up
+    for (std::size_t i = awake_; i > 0; --i)
+    {
+        if (speedX_[i - 1] == 0.f && speedY_[i - 1] == 0.f)
+        {
+            swap((unsigned int)i - 1, (unsigned int)awake_ - 1);
+            awake_--;
+            sleepVersion_++;
+        }
+    }
+}
+
+void integrate(float* x, float* y, float* prevX, float* prevY, const float* speedX, const float* speedY,
+    std::size_t count, float ms)
+{
+    std::size_t i = 0;
+
+#if defined(TRANSFORM_AVX)
+    __m256 time = _mm256_set1_ps(ms);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 moveX = _mm256_mul_ps(_mm256_loadu_ps(speedX + i), time);
+        __m256 moveY = _mm256_mul_ps(_mm256_loadu_ps(speedY + i), time);
+        __m256 posX = _mm256_loadu_ps(x + i);
+        __m256 posY = _mm256_loadu_ps(y + i);
+        _mm256_storeu_ps(prevX + i, posX);
+        _mm256_storeu_ps(prevY + i, posY);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(posX, moveX));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(posY, moveY));
+    }
+#elif defined(TRANSFORM_SSE)
+    __m128 time = _mm_set1_ps(ms);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 moveX = _mm_mul_ps(_mm_loadu_ps(speedX + i), time);
+        __m128 moveY = _mm_mul_ps(_mm_loadu_ps(speedY + i), time);
+        __m128 posX = _mm_loadu_ps(x + i);
+        __m128 posY = _mm_loadu_ps(y + i);
+        _mm_storeu_ps(prevX + i, posX);
+        _mm_storeu_ps(prevY + i, posY);
+        _mm_storeu_ps(x + i, _mm_add_ps(posX, moveX));
+        _mm_storeu_ps(y + i, _mm_add_ps(posY, moveY));
+    }
+#endif
+
+    integrateScalar(x + i, y + i, prevX + i, prevY + i, speedX + i, speedY + i, count - i, ms);
+}
+
+void integrateScalar(float* x, float* y, float* prevX, float* prevY, const float* speedX, const float* speedY,
+    std::size_t count, float ms)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        x[i] += speedX[i] * ms;
+        y[i] += speedY[i] * ms;
+    }
+}
+
+void computeBounds(float x, float y, float moveX, float moveY, float width, float height,
+    float& minX, float& minY, float& maxX, float& maxY)
+{
+    minX = std::min(x, x - moveX) - width / 2;
+    minY = std::min(y, y - moveY) - height / 2;
+    maxX = std::max(x, x - moveX) + width / 2;
+    maxY = std::max(y, y - moveY) + height / 2;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#ifndef TRANSFORM_STORE_HPP
+#define TRANSFORM_STORE_HPP
+
+#include <SFML/System.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+class Entity;
+
+/**
+ * Represent a storage of positions, velocities and sizes of entities.
+ * Each component is stored in its own array (structure of arrays), so movement
+ * of all entities can be integrated by one vectorized loop.
+ * Store also caches bounds of entities, which are computed once per update after integration
+ * and cover whole movement of entity during the update (so fast entity cannot skip over other entity).
+ * Transforms are partitioned to awake (dynamic) ones at the beginning of arrays and sleeping
+ * (static) ones behind them. Transform without speed falls asleep after its bounds are computed,
+ * sleeping transforms are not integrated and their bounds are not recomputed. Any change of position,
+ * speed or size wakes transform up, so indices of transforms can change (owners are updated).
+ * Store also keeps positions before the last integration, rendering interpolates between them
+ * and current positions (positions set directly are not interpolated).
+ */
+class TransformStore
+{
+public:
+    /**
+     * Index which never belongs to any transform.
+     */
+    static constexpr unsigned int npos = ~0u;
+
+    /**
+     * Add transform of an entity.
+     *
+     * \param owner Entity which owns the transform.
+     * \return Index of the transform.
+     */
+    unsigned int add(Entity* owner, sf::Vector2f pos, sf::Vector2f speed, sf::Vector2f size);
+    /**
+     * Remove transform, last transform is moved to its place and index of its owner is updated.
+     *
+     * \param index Index of transform to remove.
+     */
+    void remove(unsigned int index);
+    /**
+     * Move all transforms by their velocity, previous positions are kept for interpolation.
+     *
+     * \param ms Ellapsed time in ms.
+     */
+    void integrate(float ms);
+    /**
+     * Compute bounds of awake transforms from their position, size and movement during last integration,
+     * then put transforms without speed to sleep.
+     *
+     * \param ms Ellapsed time in ms used by last integration.
+     */
+    void updateBounds(float ms);
+
+    sf::Vector2f getPos(unsigned int index) const { return sf::Vector2f(x_[index], y_[index]); }
+    void setPos(unsigned int index, sf::Vector2f pos)
+    {
+        if (pos == getPos(index))
+            return;
+        index = wake(index);
+        x_[index] = prevX_[index] = pos.x;
+        y_[index] = prevY_[index] = pos.y;
+    }
+    /**
+     * Get position before the last integration (renderer interpolates from it to current position).
+     *
+     */
+    sf::Vector2f getPrevPos(unsigned int index) const { return sf::Vector2f(prevX_[index], prevY_[index]); }
+    /**
+     * Move transforms of several entities by the same offset (e.g. enemies of a formation).
+     *
+     * \param owners Entities whose transforms are moved.
+     * \param count Number of entities.
+     */
+    void translate(Entity* const* owners, std::size_t count, sf::Vector2f offset);
+    sf::Vector2f getSpeed(unsigned int index) const { return sf::Vector2f(speedX_[index], speedY_[index]); }
+    void setSpeed(unsigned int index, sf::Vector2f speed)
+    {
+        if (speed == getSpeed(index))
+            return;
+        index = wake(index);
+        speedX_[index] = speed.x;
+        speedY_[index] = speed.y;
+    }
+    sf::Vector2f getSize(unsigned int index) const { return sf::Vector2f(width_[index], height_[index]); }
+    void setSize(unsigned int index, sf::Vector2f size)
+    {
+        if (size == getSize(index))
+            return;
+        index = wake(index);
+        width_[index] = size.x;
+        height_[index] = size.y;
+    }
+    /**
+     * Get bounds computed by the last updateBounds (or by add for transforms added since).
+     *
+     */
+    sf::FloatRect getBounds(unsigned int index) const
+    {
+        return sf::FloatRect(minX_[index], minY_[index], maxX_[index] - minX_[index], maxY_[index] - minY_[index]);
+    }
+    /**
+     * Get number of stored transforms.
+     *
+     */
+    std::size_t size() const { return owners_.size(); }
+    /**
+     * Get number of awake transforms (awake transforms have indices from 0 to this number).
+     *
+     */
+    std::size_t getAwake() const { return awake_; }
+    /**
+     * Get entity which owns transform.
+     *
+     */
+    Entity* getOwner(unsigned int index) const { return owners_[index]; }
+    /**
+     * Get number which changes every time set of sleeping transforms changes.
+     *
+     */
+    unsigned int getSleepVersion() const { return sleepVersion_; }
+private:
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> prevX_;
+    std::vector<float> prevY_;
+    std::vector<float> speedX_;
+    std::vector<float> speedY_;
+    std::vector<float> width_;
+    std::vector<float> height_;
+    std::vector<float> minX_;
+    std::vector<float> minY_;
+    std::vector<float> maxX_;
+    std::vector<float> maxY_;
+    /**
+     * Entities which own transforms.
+     */
+    std::vector<Entity*> owners_;
+    /**
+     * Number of awake transforms.
+     */
+    std::size_t awake_{ 0 };
+    unsigned int sleepVersion_{ 0 };
+
+    /**
+     * Move transform to the awake partition.
+     *
+     * \return New index of the transform.
+     */
+    unsigned int wake(unsigned int index);
+    /**
+     * Exchange two transforms and update indices of their owners.
+     *
+     */
+    void swap(unsigned int first, unsigned int second);
+};
+
+/**
+ * Compute prev = pos, pos += speed * ms for two arrays of coordinates (SSE/AVX when available).
+ *
+ * \param count Number of elements in each array.
+ */
+void integrate(float* x, float* y, float* prevX, float* prevY, const float* speedX, const float* speedY,
+    std::size_t count, float ms);
+/**
+ * Scalar version of integrate, used for tails of vectorized loop and when no SIMD is available.
+ *
+ */
+void integrateScalar(float* x, float* y, float* prevX, float* prevY, const float* speedX, const float* speedY,
+    std::size_t count, float ms);
+/**
+ * Compute bounds of one transform, which contain its box at current position and at position before move.
+ *
+ * \param moveX Movement along x axis during last update.
+ * \param moveY Movement along y axis during last update.
+ */
+void computeBounds(float x, float y, float moveX, float moveY, float width, float height,
+    float& minX, float& minY, float& maxX, float& maxY);
+
+#endif // !TRANSFORM_STORE_HPP
@@ -0,0 +1,53 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * Represent three values passed from one producer thread to one consumer thread without locks.
+ * Producer writes to its back value and publishes it, consumer takes the latest published value.
+ * Neither side ever waits: producer always has a free value to write and consumer keeps
+ * its front value until a newer one is published (older unread values are skipped).
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * Get value which producer writes (owned by producer until publish).
+     * 
+     */
+    T& getBack() { return values_[back_]; }
+    /**
+     * Publish back value, producer gets the value which was published before and not taken.
+     * 
+     */
+    void publish()
+    {
+        back_ = middle_.exchange(back_ | fresh_, std::memory_order_acq_rel) & index_;
+    }
+    /**
+     * Get the latest published value (owned by consumer until the next take).
+     * 
+     */
+    const T& take()
+    {
+        if ((middle_.load(std::memory_order_relaxed) & fresh_) != 0)
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index_;
+
+        return values_[front_];
+    }
+private:
+    /**
+     * Middle index has this bit set when it holds a value which consumer did not take yet.
+     */
+    static constexpr unsigned int fresh_ = 0x4;
+    static constexpr unsigned int index_ = 0x3;
+
+    T values_[3];
+    unsigned int back_{ 0 };
+    unsigned int front_{ 1 };
+    std::atomic<unsigned int> middle_{ 2 };
+};
+
+#endif // !TRIPLE_BUFFER_HPP
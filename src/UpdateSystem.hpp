@@ -0,0 +1,73 @@
+#ifndef UPDATE_SYSTEM_HPP
+#define UPDATE_SYSTEM_HPP
+
+#include <SFML/System.hpp>
+#include <vector>
+
+class Entity;
+
+/**
+ * Represent an interface of update system, game state calls it once per update
+ * (not once per entity).
+ */
+class IUpdateSystem
+{
+public:
+    virtual ~IUpdateSystem() {}
+
+    /**
+     * Update all entities of the system.
+     *
+     * \param elapsed Ellapsed time from last update.
+     */
+    virtual void update(const sf::Time& elapsed) = 0;
+    /**
+     * Remove entity from the system.
+     *
+     */
+    virtual void remove(Entity* entity) = 0;
+};
+
+/**
+ * Represent a system which updates all entities of one concrete type.
+ * Entities are stored in homogeneous container and T::update is called without
+ * virtual dispatch, so compiler can inline it into the loop.
+ */
+template <typename T>
+class UpdateSystem final : public IUpdateSystem
+{
+public:
+    /**
+     * Add entity to the system.
+     *
+     */
+    void add(T* entity)
+    {
+        entity->system_ = this;
+        entity->systemSlot_ = (unsigned int)entities_.size();
+        entities_.push_back(entity);
+    }
+
+    void remove(Entity* entity) override
+    {
+        T* removed = static_cast<T*>(entity);
+        unsigned int slot = removed->systemSlot_;
+
+        // move last entity into the hole
+        entities_[slot] = entities_.back();
+        entities_[slot]->systemSlot_ = slot;
+        entities_.pop_back();
+
+        removed->system_ = nullptr;
+    }
+
+    void update(const sf::Time& elapsed) override
+    {
+        for (T* entity : entities_)
+            entity->T::update(elapsed);
+    }
+private:
+    std::vector<T*> entities_;
+};
+
+#endif // !UPDATE_SYSTEM_HPP